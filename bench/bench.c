@@ -0,0 +1,1069 @@
+/**
+ *  @file       bench.c
+ *  @brief      Micro and frame benchmarks, with a baseline comparison.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The benchmark suite run by `make bench`.  Times the collision
+ *  narrowphase, the meteor integration, the laser pool, the dice, the
+ *  ticks of a bare World, a batch environment, sprite loading (PNG and
+ *  pack) and, given the game binary, whole game ticks without rendering
+ *  at several meteor counts.  Each result is the median of RUNS runs, in
+ *  nanoseconds per operation.
+ *
+ *  The results are written as JSON.  With --compare, they are checked
+ *  against a stored baseline and any result slower than the baseline by
+ *  more than the threshold (in percent) fails the run.
+ **/
+
+#include <dirent.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include "collide.h"
+#include "dice.h"
+#include "env.h"
+#include "laser.h"
+#include "meteor.h"
+#include "pack.h"
+#include "save.h"
+#include "sim.h"
+
+#define RUNS 5      // 每項測 RUNS 次取中位數
+#define PAIRS 1024  // 預先產生的測試資料組數
+#define RESULTS_MAX 64
+#define IMAGES_MAX 64
+#define BENCH_NAME_MAX 48
+
+#define WIDTH 1920
+#define HEIGHT 1080
+
+#define IMG_DIR "bin/img"  // 與遊戲相同的圖檔與 pack
+#define PACK_FILE "bin/img/img.pack"
+
+typedef void (*BenchFn)(int);
+
+typedef struct {
+  char name_[BENCH_NAME_MAX];
+  int n_;      // operations per run
+  double ns_;  // median nanoseconds per operation
+} BenchResult;
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static double time_(BenchFn, int);
+static int by_value_(void const *, void const *);
+static void record_(char const *, int, double);
+
+static void circle_(Bitmask *, int);
+static void setup_collide_(void);
+static void aabb_(int);
+static void batch_(int);
+static void gjk_(int);
+static void masks_(int);
+static void sweep_(int);
+
+static void integrate_(int);
+static void pool_(int);
+static void roll_(int);
+static void world_(int, int);
+static void step_(int);
+static void save_(int);
+static void restore_(int);
+static void delta_(int);
+static void env_(int, int);
+static void env_step_(int);
+
+static int find_images_(void);
+static void load_(int);
+static void unpack_(int);
+
+static bool ticks_(char const *, int, int);
+
+static bool write_(char const *);
+static int compare_(char const *, double);
+
+// 內部資料欄位 (private data) 宣告
+static BenchResult results_[RESULTS_MAX];
+static int results_count_ = 0;
+
+static volatile uint32_t sink_ = 0;  // 讓編譯器保留被測的呼叫
+
+static Rect boxes_[PAIRS][2];
+static int32_t columns_[4][PAIRS];  // boxes_[i][1] 的 x, y, w, h 各欄
+static int32_t hits_[PAIRS];
+static Bitmask circles_[PAIRS];
+static Rect laser_box_ = {0, 0, 9, 54};
+static Bitmask laser_mask_;
+
+static MeteorStore meteors_;
+static LaserPool lasers_;
+static World world_state_;
+static uint8_t *saves_[3];  // 前一個 tick, 這個 tick, delta
+static size_t save_sizes_[3];
+static EnvBatch env_batch_;
+static Input *env_actions_;
+static EnvOutput env_out_;
+
+static char *images_[IMAGES_MAX];
+static int images_count_ = 0;
+static Pack pack_;
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Run `fn` over `n` operations RUNS times, after one warm-up run.
+ *
+ *  @param BenchFn the benchmark body.
+ *  @param int the number of operations per run.
+ *  @return double the median nanoseconds per operation.
+ *  @since  0.1.0
+ **/
+double time_(BenchFn fn, int n) {
+  double samples[RUNS];
+  double const frequency = (double)SDL_GetPerformanceFrequency();
+
+  fn(n);
+
+  for (int r = 0; r < RUNS; ++r) {
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    fn(n);
+
+    samples[r] =
+        (double)(SDL_GetPerformanceCounter() - start) * 1e9 / frequency / n;
+  }  // od
+
+  qsort(samples, RUNS, sizeof(double), by_value_);
+
+  return samples[RUNS / 2];
+}  // time_()
+
+/**
+ *  qsort() comparator of doubles.
+ *
+ *  @since  0.1.0
+ **/
+int by_value_(void const *a, void const *b) {
+  double x = *(double const *)a;
+  double y = *(double const *)b;
+
+  return (x > y) - (x < y);
+}  // by_value_()
+
+/**
+ *  Keep one result and print it.
+ *
+ *  @since  0.1.0
+ **/
+void record_(char const *name, int n, double ns) {
+  BenchResult *result = (BenchResult *)NULL;
+
+  if (results_count_ == RESULTS_MAX) {
+    printf("Bench Error: more than %d results\n", RESULTS_MAX);
+    exit(-1);
+  }  // fi
+
+  result = &results_[results_count_];
+
+  snprintf(result->name_, BENCH_NAME_MAX, "%s", name);
+  result->n_ = n;
+  result->ns_ = ns;
+
+  results_count_ += 1;
+
+  printf("%-28s %12.2f ns\n", name, ns);
+  fflush(stdout);
+}  // record_()
+
+/**
+ *  Fill a square mask with a disc touching its sides, the shape of
+ *  a typical meteor sprite.
+ *
+ *  @since  0.1.0
+ **/
+void circle_(Bitmask *mask, int size) {
+  extern Collide collide;
+
+  int r = size / 2;
+
+  collide.mask_alloc(mask, size, size);
+
+  for (int y = 0; y < size; ++y) {
+    for (int x = 0; x < size; ++x) {
+      int dx = x - r;
+      int dy = y - r;
+
+      if (dx * dx + dy * dy <= r * r) {
+        mask->bits_[y * mask->words_ + x / 64] |= (uint64_t)1 << (x % 64);
+      }  // fi
+    }    // od
+  }      // od
+}  // circle_()
+
+/**
+ *  Make PAIRS pairs of meteor sized boxes, near enough that about
+ *  half of them overlap, and a disc mask for each.
+ *
+ *  @since  0.1.0
+ **/
+void setup_collide_(void) {
+  extern Collide collide;
+
+  srand(1);
+
+  for (int i = 0; i < PAIRS; ++i) {
+    int size = 20 + rand() % 80;
+
+    boxes_[i][0].x = rand() % WIDTH;
+    boxes_[i][0].y = rand() % HEIGHT;
+    boxes_[i][0].w = size;
+    boxes_[i][0].h = size;
+
+    boxes_[i][1].x = boxes_[i][0].x + rand() % (2 * size) - size;
+    boxes_[i][1].y = boxes_[i][0].y + rand() % (2 * size) - size;
+    boxes_[i][1].w = size;
+    boxes_[i][1].h = size;
+
+    columns_[0][i] = boxes_[i][1].x;
+    columns_[1][i] = boxes_[i][1].y;
+    columns_[2][i] = boxes_[i][1].w;
+    columns_[3][i] = boxes_[i][1].h;
+
+    circle_(&circles_[i], size);
+  }  // od
+
+  collide.mask_alloc(&laser_mask_, laser_box_.w, laser_box_.h);
+
+  for (int y = 0; y < laser_box_.h; ++y) {
+    laser_mask_.bits_[y * laser_mask_.words_] = (1u << laser_box_.w) - 1;
+  }  // od
+}  // setup_collide_()
+
+/**
+ *  Collide::aabb on the box pairs.
+ *
+ *  @since  0.1.0
+ **/
+void aabb_(int n) {
+  extern Collide collide;
+
+  uint32_t hits = 0;
+
+  for (int i = 0; i < n; ++i) {
+    Rect const *pair = boxes_[i % PAIRS];
+
+    hits += collide.aabb(&pair[0], &pair[1]);
+  }  // od
+
+  sink_ += hits;
+}  // aabb_()
+
+/**
+ *  Collide::aabb_batch, each first box against all the second ones;
+ *  one operation per pair.
+ *
+ *  @since  0.1.0
+ **/
+void batch_(int n) {
+  extern Collide collide;
+
+  uint32_t hits = 0;
+
+  for (int i = 0; i < n / PAIRS; ++i) {
+    hits += (uint32_t)collide.aabb_batch(
+        &boxes_[i % PAIRS][0], columns_[0], columns_[1], columns_[2],
+        columns_[3], PAIRS, hits_);
+  }  // od
+
+  sink_ += hits;
+}  // batch_()
+
+/**
+ *  Collide::gjk on the box pairs, as rectangle colliders.
+ *
+ *  @since  0.1.0
+ **/
+void gjk_(int n) {
+  extern Collide collide;
+
+  uint32_t hits = 0;
+
+  for (int i = 0; i < n; ++i) {
+    Rect const *pair = boxes_[i % PAIRS];
+    Collider a = {COLLIDER_AABB, pair[0], 0, (Point const *)NULL};
+    Collider b = {COLLIDER_AABB, pair[1], 0, (Point const *)NULL};
+
+    hits += collide.gjk(&a, &b);
+  }  // od
+
+  sink_ += hits;
+}  // gjk_()
+
+/**
+ *  Collide::masks on the disc pairs.
+ *
+ *  @since  0.1.0
+ **/
+void masks_(int n) {
+  extern Collide collide;
+
+  uint32_t hits = 0;
+
+  for (int i = 0; i < n; ++i) {
+    int k = i % PAIRS;
+
+    hits += collide.masks(&boxes_[k][0], &circles_[k], &boxes_[k][1],
+                          &circles_[k]);
+  }  // od
+
+  sink_ += hits;
+}  // masks_()
+
+/**
+ *  Collide::sweep of a laser, one tick up the screen, against a
+ *  drifting disc, the way collide_lasers_() does.
+ *
+ *  @since  0.1.0
+ **/
+void sweep_(int n) {
+  extern Collide collide;
+
+  Point move = {0, -30};
+  Point drift = {1, 2};
+  uint32_t hits = 0;
+
+  for (int i = 0; i < n; ++i) {
+    int k = i % PAIRS;
+    Rect laser = laser_box_;
+    float toi = 0.0f;
+
+    laser.x = boxes_[k][1].x + boxes_[k][1].w / 2;
+    laser.y = boxes_[k][1].y + boxes_[k][1].h;
+
+    hits += collide.sweep(&laser, &laser_mask_, &move, &boxes_[k][0],
+                          &circles_[k], &drift, &toi);
+  }  // od
+
+  sink_ += hits;
+}  // sweep_()
+
+/**
+ *  MeteorKernel::integrate over the meteor store, one operation per
+ *  meteor; the culled meteors respawn above the scene as in the game.
+ *
+ *  @since  0.1.0
+ **/
+void integrate_(int n) {
+  extern MeteorKernel meteor_kernel;
+
+  int passes = n / meteors_.count_;
+
+  for (int p = 0; p < passes; ++p) {
+    int culls = meteor_kernel.integrate(&meteors_, WIDTH, HEIGHT);
+
+    for (int k = 0; k < culls; ++k) {
+      int i = meteors_.culled_[k];
+
+      meteors_.y_[i] = -meteors_.h_[i];
+      meteors_.x_[i] = (int32_t)((uint32_t)i * 7919u % WIDTH);
+    }  // od
+
+    sink_ += culls;
+  }  // od
+}  // integrate_()
+
+/**
+ *  LaserAllocator::alloc and ::destroy, kept around half full.
+ *
+ *  @since  0.1.0
+ **/
+void pool_(int n) {
+  extern Dice dice;
+  extern LaserAllocator laser_allocator;
+
+  for (int i = 0; i < n; ++i) {
+    if ((lasers_.count_ > 0) &&
+        ((lasers_.count_ == lasers_.capacity_) || (i & 1))) {
+      laser_allocator.destroy(&lasers_,
+                              (int)dice.roll((uint32_t)lasers_.count_));
+    }  // fi
+    else {
+      laser_allocator.alloc(&lasers_)->idx = i;
+    }  // esle
+  }    // od
+
+  sink_ += lasers_.count_;
+}  // pool_()
+
+/**
+ *  Dice::roll.
+ *
+ *  @since  0.1.0
+ **/
+void roll_(int n) {
+  extern Dice dice;
+
+  uint32_t sum = 0;
+
+  for (int i = 0; i < n; ++i) {
+    sum += dice.roll(1000);
+  }  // od
+
+  sink_ += sum;
+}  // roll_()
+
+/**
+ *  Make a stress world of `meteors` meteors (solid shapes, no
+ *  masks) and record the time of its ticks, saves, loads and deltas,
+ *  without SDL or threads.
+ *
+ *  @param int number of meteors.
+ *  @param int number of ticks per run.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void world_(int meteors, int ticks) {
+  extern Simulator simulator;
+  extern WorldSaver world_saver;
+
+  char name[BENCH_NAME_MAX];
+  WorldConfig config;
+
+  memset(&config, 0, sizeof(WorldConfig));
+
+  config.seed_ = 1;
+  config.width_ = WIDTH;
+  config.height_ = HEIGHT;
+  config.meteors_ = meteors;
+  config.stress_ = true;
+
+  // 與隕石圖檔相近的大小
+  config.kinds_ = 10;
+
+  for (int k = 0; k < config.kinds_; ++k) {
+    config.meteor_shapes_[k].w_ = 18 + 9 * k;
+    config.meteor_shapes_[k].h_ = 18 + 7 * k;
+  }  // od
+
+  config.ship_.w_ = 99;
+  config.ship_.h_ = 75;
+  config.laser_.w_ = 9;
+  config.laser_.h_ = 54;
+
+  simulator.init(&world_state_, &config, (WorldHooks const *)NULL);
+
+  snprintf(name, sizeof(name), "world.step/%d", meteors);
+  record_(name, ticks, time_(step_, ticks));
+
+  // 存檔, 兩個相隔一個 tick 的存檔做 delta
+  size_t const bound = world_saver.bound(&world_state_);
+
+  for (int i = 0; i < 3; ++i) {
+    saves_[i] = (uint8_t *)malloc(bound);
+  }  // od
+
+  save_sizes_[0] = world_saver.save(&world_state_, saves_[0], bound);
+  step_(1);
+  save_sizes_[1] = world_saver.save(&world_state_, saves_[1], bound);
+
+  snprintf(name, sizeof(name), "world.save/%d", meteors);
+  record_(name, ticks * 10, time_(save_, ticks * 10));
+
+  snprintf(name, sizeof(name), "world.load/%d", meteors);
+  record_(name, ticks * 10, time_(restore_, ticks * 10));
+
+  snprintf(name, sizeof(name), "world.delta/%d", meteors);
+  record_(name, ticks * 10, time_(delta_, ticks * 10));
+
+  printf("Bench: world.delta/%d %zu of %zu bytes\n", meteors,
+         save_sizes_[2], save_sizes_[1]);
+
+  for (int i = 0; i < 3; ++i) {
+    free(saves_[i]);
+  }  // od
+
+  simulator.release(&world_state_);
+}  // world_()
+
+/**
+ *  Simulator::step with the stress pilot, one operation per tick.
+ *
+ *  @since  0.1.0
+ **/
+void step_(int n) {
+  extern Simulator simulator;
+
+  Input input = {false, false, false, false, false, false};
+
+  for (int t = 0; t < n; ++t) {
+    simulator.pilot(&world_state_, &input);
+    simulator.step(&world_state_, &input);
+  }  // od
+
+  sink_ += world_state_.tick_;
+}  // step_()
+
+/**
+ *  WorldSaver::save of the bench world, one operation per save.
+ *
+ *  @since  0.1.0
+ **/
+void save_(int n) {
+  extern WorldSaver world_saver;
+
+  size_t const bound = world_saver.bound(&world_state_);
+
+  for (int i = 0; i < n; ++i) {
+    sink_ += (uint32_t)world_saver.save(&world_state_, saves_[2], bound);
+  }  // od
+}  // save_()
+
+/**
+ *  WorldSaver::load of the latest save into the bench world.
+ *
+ *  @since  0.1.0
+ **/
+void restore_(int n) {
+  extern WorldSaver world_saver;
+
+  for (int i = 0; i < n; ++i) {
+    sink_ += world_saver.load(&world_state_, saves_[1], save_sizes_[1]);
+  }  // od
+}  // restore_()
+
+/**
+ *  WorldSaver::delta of the latest save against the one a tick
+ *  earlier.
+ *
+ *  @since  0.1.0
+ **/
+void delta_(int n) {
+  extern WorldSaver world_saver;
+
+  size_t const bound = world_saver.bound(&world_state_);
+
+  for (int i = 0; i < n; ++i) {
+    save_sizes_[2] = world_saver.delta(saves_[0], save_sizes_[0], saves_[1],
+                                       save_sizes_[1], saves_[2], bound);
+  }  // od
+
+  sink_ += (uint32_t)save_sizes_[2];
+}  // delta_()
+
+/**
+ *  Make a batch of `worlds` small worlds, as a trainer would, and
+ *  record the time of one env step (one world, one tick), on the
+ *  calling thread only.
+ *
+ *  @param int number of worlds.
+ *  @param int number of batch steps per run.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void env_(int worlds, int steps) {
+  extern VecEnv vec_env;
+
+  char name[BENCH_NAME_MAX];
+  EnvConfig config;
+  WorldConfig *world = &config.world_;
+
+  memset(&config, 0, sizeof(EnvConfig));
+
+  config.count_ = worlds;
+  config.max_ticks_ = 1000;
+  config.nearest_ = 8;
+  config.grid_w_ = 32;
+  config.grid_h_ = 24;
+
+  world->seed_ = 1;
+  world->width_ = 640;
+  world->height_ = 480;
+  world->meteors_ = 32;
+  world->kinds_ = 10;
+
+  for (int k = 0; k < world->kinds_; ++k) {
+    world->meteor_shapes_[k].w_ = 18 + 9 * k;
+    world->meteor_shapes_[k].h_ = 18 + 7 * k;
+  }  // od
+
+  world->ship_.w_ = 99;
+  world->ship_.h_ = 75;
+  world->laser_.w_ = 9;
+  world->laser_.h_ = 54;
+
+  vec_env.init(&env_batch_, &config, (WorldHooks const *)NULL);
+
+  env_actions_ = (Input *)calloc(worlds, sizeof(Input));
+  env_out_.reward_ = (float *)malloc(sizeof(float) * worlds);
+  env_out_.done_ = (uint8_t *)malloc(sizeof(uint8_t) * worlds);
+  env_out_.entities_ = (float *)malloc(
+      sizeof(float) * worlds * vec_env.entity_floats(&env_batch_));
+  env_out_.grid_ = (uint8_t *)NULL;
+
+  for (int i = 0; i < worlds; ++i) {
+    env_actions_[i].fire_ = true;
+    env_actions_[i].left_ = (i % 2 == 0);
+  }  // od
+
+  vec_env.reset(&env_batch_, &env_out_);
+
+  snprintf(name, sizeof(name), "env.step/%d", worlds);
+  record_(name, worlds * steps, time_(env_step_, worlds * steps));
+
+  vec_env.release(&env_batch_);
+
+  free(env_actions_);
+  free(env_out_.reward_);
+  free(env_out_.done_);
+  free(env_out_.entities_);
+}  // env_()
+
+/**
+ *  VecEnv::step over the whole batch, one operation per world and
+ *  tick.
+ *
+ *  @since  0.1.0
+ **/
+void env_step_(int n) {
+  extern VecEnv vec_env;
+
+  for (int t = 0; t < n / env_batch_.config_.count_; ++t) {
+    vec_env.step(&env_batch_, env_actions_, &env_out_);
+  }  // od
+
+  sink_ += env_batch_.worlds_[0].tick_;
+}  // env_step_()
+
+/**
+ *  Collect the PNG paths under IMG_DIR.
+ *
+ *  @return int the number of images found.
+ *  @since  0.1.0
+ **/
+int find_images_(void) {
+  DIR *dir = opendir(IMG_DIR);
+  struct dirent *entry = (struct dirent *)NULL;
+
+  if (dir == (DIR *)NULL) {
+    return 0;
+  }  // fi
+
+  while (((entry = readdir(dir)) != (struct dirent *)NULL) &&
+         (images_count_ < IMAGES_MAX)) {
+    size_t length = strlen(entry->d_name);
+
+    if ((length > 4) && (strcmp(entry->d_name + length - 4, ".png") == 0)) {
+      images_[images_count_] =
+          (char *)malloc(strlen(IMG_DIR) + 1 + length + 1);
+      sprintf(images_[images_count_], "%s/%s", IMG_DIR, entry->d_name);
+
+      images_count_ += 1;
+    }  // fi
+  }    // od
+
+  closedir(dir);
+
+  return images_count_;
+}  // find_images_()
+
+/**
+ *  IMG_Load, one operation per image.
+ *
+ *  @since  0.1.0
+ **/
+void load_(int n) {
+  for (int i = 0; i < n; ++i) {
+    SDL_Surface *surface = IMG_Load(images_[i % images_count_]);
+
+    if (surface != (SDL_Surface *)NULL) {
+      sink_ += surface->w;
+      SDL_FreeSurface(surface);
+    }  // fi
+  }    // od
+}  // load_()
+
+/**
+ *  AssetPack::surface on the open pack, one operation per image.
+ *
+ *  @since  0.1.0
+ **/
+void unpack_(int n) {
+  extern AssetPack asset_pack;
+
+  for (int i = 0; i < n; ++i) {
+    SDL_Surface *surface = asset_pack.surface(
+        &pack_, pack_.entries_[i % pack_.count_].name_);
+
+    if (surface != (SDL_Surface *)NULL) {
+      sink_ += surface->w;
+      SDL_FreeSurface(surface);
+    }  // fi
+  }    // od
+}  // unpack_()
+
+/**
+ *  Run the game headless, in stress mode, for `ticks` ticks with
+ *  `meteors` meteors, RUNS times, and record the median time per
+ *  tick the game reports on its "Session:" line.  It runs with
+ *  --headless=none, so nothing is rendered: the result is the cost of
+ *  a game tick (simulation and snapshot), not of a frame.  The game
+ *  runs in its own directory, where its img/ is.
+ *
+ *  @param char const * the game binary.
+ *  @param int number of meteors.
+ *  @param int number of ticks.
+ *  @return bool false if a run failed; nothing is recorded then.
+ *  @since  0.1.0
+ **/
+bool ticks_(char const *game, int meteors, int ticks) {
+  char command[512];
+  char name[BENCH_NAME_MAX];
+  double samples[RUNS];
+
+  char const *slash = strrchr(game, '/');
+
+  // 在遊戲所在的目錄執行, 它以相對路徑載入 img/
+  if (slash != (char const *)NULL) {
+    snprintf(command, sizeof(command),
+             "cd '%.*s' && ./'%s' --headless=none --fast --stress --seed 1 "
+             "--frames %d --meteors %d 2>&1",
+             (int)(slash - game), game, slash + 1, ticks, meteors);
+  }  // fi
+  else {
+    snprintf(command, sizeof(command),
+             "./'%s' --headless=none --fast --stress --seed 1 --frames %d "
+             "--meteors %d 2>&1",
+             game, ticks, meteors);
+  }  // esle
+
+  for (int r = 0; r < RUNS; ++r) {
+    char line[256];
+    unsigned int done = 0;
+    double ms = 0.0;
+    FILE *pipe = popen(command, "r");
+
+    if (pipe == (FILE *)NULL) {
+      printf("Bench: cannot run %s, tick.headless/%d skipped\n", game,
+             meteors);
+      return false;
+    }  // fi
+
+    while (fgets(line, sizeof(line), pipe) != (char *)NULL) {
+      sscanf(line, "Session: %u ticks in %lf ms", &done, &ms);
+    }  // od
+
+    if ((pclose(pipe) != 0) || (done == 0)) {
+      printf("Bench: %s did not finish, tick.headless/%d skipped\n",
+             command, meteors);
+      return false;
+    }  // fi
+
+    samples[r] = ms * 1e6 / done;
+  }  // od
+
+  qsort(samples, RUNS, sizeof(double), by_value_);
+
+  snprintf(name, sizeof(name), "tick.headless/%d", meteors);
+  record_(name, ticks, samples[RUNS / 2]);
+
+  return true;
+}  // ticks_()
+
+/**
+ *  Write the results as JSON, one result per line.
+ *
+ *  @param char const * the file, NULL for stdout.
+ *  @return bool false if the file cannot be written.
+ *  @since  0.1.0
+ **/
+bool write_(char const *path) {
+  FILE *file = stdout;
+
+  if (path != (char const *)NULL) {
+    file = fopen(path, "w");
+
+    if (file == (FILE *)NULL) {
+      return false;
+    }  // fi
+  }    // fi
+
+  fprintf(file, "{\n  \"version\": 1,\n  \"unit\": \"ns/op\",\n");
+  fprintf(file, "  \"results\": [\n");
+
+  for (int i = 0; i < results_count_; ++i) {
+    fprintf(file, "    {\"name\": \"%s\", \"n\": %d, \"ns\": %.3f}%s\n",
+            results_[i].name_, results_[i].n_, results_[i].ns_,
+            (i + 1 < results_count_) ? "," : "");
+  }  // od
+
+  fprintf(file, "  ]\n}\n");
+
+  if (file != stdout) {
+    fclose(file);
+  }  // fi
+
+  return true;
+}  // write_()
+
+/**
+ *  Compare the results with a baseline written by write_().  Results
+ *  missing from either side are listed but never fail.
+ *
+ *  @param char const * the baseline file.
+ *  @param double the allowed slowdown, in percent.
+ *  @return int the number of regressions, -1 without a baseline.
+ *  @since  0.1.0
+ **/
+int compare_(char const *path, double threshold) {
+  char line[256];
+  int regressions = 0;
+  FILE *file = fopen(path, "r");
+
+  if (file == (FILE *)NULL) {
+    return -1;
+  }  // fi
+
+  printf("\n%-28s %12s %12s %8s\n", "benchmark", "baseline", "current",
+         "change");
+
+  while (fgets(line, sizeof(line), file) != (char *)NULL) {
+    char name[BENCH_NAME_MAX];
+    int n = 0;
+    double ns = 0.0;
+    BenchResult const *current = (BenchResult const *)NULL;
+
+    if (sscanf(line, " {\"name\": \"%47[^\"]\", \"n\": %d, \"ns\": %lf}",
+               name, &n, &ns) != 3) {
+      continue;
+    }  // fi
+
+    for (int i = 0; i < results_count_; ++i) {
+      if (strcmp(results_[i].name_, name) == 0) {
+        current = &results_[i];
+      }  // fi
+    }    // od
+
+    if (current == (BenchResult const *)NULL) {
+      printf("%-28s %12.2f %12s\n", name, ns, "-");
+    }  // fi
+    else {
+      double change = (current->ns_ - ns) * 100.0 / ns;
+      bool regressed = change > threshold;
+
+      printf("%-28s %12.2f %12.2f %+7.1f%%%s\n", name, ns, current->ns_,
+             change, regressed ? "  REGRESSION" : "");
+
+      regressions += regressed ? 1 : 0;
+    }  // esle
+  }    // od
+
+  fclose(file);
+
+  return regressions;
+}  // compare_()
+
+/**
+ *  usage: bench [--out FILE] [--compare BASELINE] [--threshold PCT]
+ *               [--game BINARY]
+ *
+ *  @return int 0, or 1 when a result regressed past the threshold or
+ *          the baseline to --compare with is missing.
+ *  @since  0.1.0
+ **/
+int main(int argc, char *argv[]) {
+  extern AssetPack asset_pack;
+  extern Collide collide;
+  extern Dice dice;
+  extern LaserAllocator laser_allocator;
+  extern MeteorKernel meteor_kernel;
+
+  static int const COUNTS[] = {1000, 10000, 100000, 1000000};
+  static int const FRAME_COUNTS[] = {1000, 10000, 100000};
+
+  char const *out = (char const *)NULL;
+  char const *baseline = (char const *)NULL;
+  char const *game = (char const *)NULL;
+  double threshold = 10.0;
+  int regressions = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    char const *next = (i + 1 < argc) ? argv[i + 1] : (char const *)NULL;
+
+    if (next == (char const *)NULL) {
+      printf("Bench Error: %s needs a value\n", argv[i]);
+      exit(-1);
+    }  // fi
+
+    if (strcmp(argv[i], "--out") == 0) {
+      out = next;
+    }  // fi
+    else if (strcmp(argv[i], "--compare") == 0) {
+      baseline = next;
+    }  // fi
+    else if (strcmp(argv[i], "--threshold") == 0) {
+      threshold = atof(next);
+    }  // fi
+    else if (strcmp(argv[i], "--game") == 0) {
+      game = next;
+    }  // fi
+    else {
+      printf("Bench Error: unknown option %s\n", argv[i]);
+      exit(-1);
+    }  // esle
+
+    i += 1;
+  }  // od
+
+  // 碰撞的 narrowphase
+  setup_collide_();
+
+  record_("collide.aabb", 1 << 22, time_(aabb_, 1 << 22));
+  record_("collide.aabb_batch", 1 << 24, time_(batch_, 1 << 24));
+  record_("collide.gjk", 1 << 20, time_(gjk_, 1 << 20));
+  record_("collide.masks", 1 << 20, time_(masks_, 1 << 20));
+  record_("collide.sweep", 1 << 18, time_(sweep_, 1 << 18));
+
+  for (int i = 0; i < PAIRS; ++i) {
+    collide.mask_release(&circles_[i]);
+  }  // od
+
+  collide.mask_release(&laser_mask_);
+
+  // 隕石的移動, 以每顆隕石計
+  for (size_t c = 0; c < sizeof(COUNTS) / sizeof(COUNTS[0]); ++c) {
+    char name[BENCH_NAME_MAX];
+    int n = (COUNTS[c] > (1 << 24)) ? COUNTS[c] : (1 << 24);
+
+    meteor_kernel.alloc(&meteors_, COUNTS[c]);
+    dice.seed(1);
+
+    for (int i = 0; i < COUNTS[c]; ++i) {
+      meteors_.x_[i] = (int32_t)dice.roll(WIDTH);
+      meteors_.y_[i] = (int32_t)dice.roll(HEIGHT);
+      meteors_.w_[i] = 20 + (int32_t)dice.roll(80);
+      meteors_.h_[i] = 20 + (int32_t)dice.roll(80);
+      meteors_.vx_[i] = (int32_t)dice.roll(5) - 2;
+      meteors_.vy_[i] = 1 + (int32_t)dice.roll(3);
+      meteors_.flags_[i] = METEOR_VISIBLE;
+    }  // od
+
+    n -= n % COUNTS[c];
+
+    snprintf(name, sizeof(name), "meteor.integrate/%d", COUNTS[c]);
+    record_(name, n, time_(integrate_, n));
+
+    meteor_kernel.release(&meteors_);
+  }  // od
+
+  // 雷射的 pool
+  laser_allocator.init(&lasers_, LASER_POOL_CAPACITY);
+  record_("laser.pool", 1 << 22, time_(pool_, 1 << 22));
+  laser_allocator.release(&lasers_);
+
+  // 亂數
+  dice.seed(1);
+  record_("dice.roll", 1 << 24, time_(roll_, 1 << 24));
+
+  // 整個模擬 tick, 單一執行緒, 不經過 SDL
+  for (size_t c = 0; c < sizeof(FRAME_COUNTS) / sizeof(FRAME_COUNTS[0]); ++c) {
+    world_(FRAME_COUNTS[c], 100000000 / (FRAME_COUNTS[c] * 100));
+  }  // od
+
+  // 批次環境, 以每個 world 的每個 tick 計
+  env_(4096, 100);
+
+  // 載入圖檔: PNG 解碼與 pack
+  IMG_Init(IMG_INIT_PNG);
+
+  if (find_images_() > 0) {
+    record_("sprite.png", images_count_ * 4,
+            time_(load_, images_count_ * 4));
+  }  // fi
+  else {
+    printf("Bench: no images under %s, sprite.png skipped\n", IMG_DIR);
+  }  // esle
+
+  if (asset_pack.open(&pack_, PACK_FILE)) {
+    record_("sprite.pack", (int)pack_.count_ * 64,
+            time_(unpack_, (int)pack_.count_ * 64));
+    asset_pack.close(&pack_);
+  }  // fi
+  else {
+    printf("Bench: no %s, sprite.pack skipped\n", PACK_FILE);
+  }  // esle
+
+  for (int i = 0; i < images_count_; ++i) {
+    free(images_[i]);
+  }  // od
+
+  IMG_Quit();
+
+  // 整個 headless tick (模擬 + 發佈 snapshot), 以每個 tick 計
+  if (game != (char const *)NULL) {
+    for (size_t c = 0; c < sizeof(FRAME_COUNTS) / sizeof(FRAME_COUNTS[0]);
+         ++c) {
+      ticks_(game, FRAME_COUNTS[c], 300);
+    }  // od
+  }    // fi
+  else {
+    printf("Bench: no --game, tick.headless skipped\n");
+  }  // esle
+
+  if (!write_(out)) {
+    printf("Bench Error: cannot write %s\n", out);
+    exit(-1);
+  }  // fi
+
+  if (baseline != (char const *)NULL) {
+    regressions = compare_(baseline, threshold);
+
+    // 沒有 baseline 就無從比較, 視為失敗, 以免回歸被放過
+    if (regressions < 0) {
+      printf("Bench Error: no baseline %s; make bench-baseline saves one\n",
+             baseline);
+    }  // fi
+    else if (regressions > 0) {
+      printf("Bench: %d regression(s) over %.1f%%\n", regressions,
+             threshold);
+    }  // esle
+  }    // fi
+
+  return (regressions != 0) ? 1 : 0;
+}  // main()
+
+// bench.c
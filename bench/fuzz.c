@@ -0,0 +1,261 @@
+/**
+ *  @file       fuzz.c
+ *  @brief      Cross-checks the AABB, batch and GJK narrowphases.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The narrowphase fuzz target run by `make fuzz`.  Random rectangle
+ *  pairs, packed into a small field so that many of them touch, go
+ *  through Collide::aabb, Collide::aabb_batch and Collide::gjk:
+ *
+ *    - aabb and aabb_batch must agree on every pair;
+ *    - gjk must agree with aabb on every pair that overlaps with a
+ *      positive area or is separated by a gap.
+ *
+ *  Pairs in zero-area contact (an edge or a corner shared, nothing
+ *  more) count as a hit for aabb, while gjk reports them either way:
+ *  whether the origin lies on the edge of its simplex depends on the
+ *  order the support points come in.  Those pairs are counted, not
+ *  failed.  The time of each path is reported in pairs per second.
+ **/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "collide.h"
+#include "dice.h"
+
+#define BATCH 1024  // 每個 a 對應的 b 個數
+#define FIELD 64    // 長方形所在的範圍, 小到常常相碰
+#define SIZE 32     // 長方形的邊長上限
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static void fill_(void);
+static double now_(void);
+static void check_(long *, long *);
+static void time_(void);
+
+// 內部資料欄位 (private data) 宣告
+static Rect a_;
+static int32_t x_[BATCH];
+static int32_t y_[BATCH];
+static int32_t w_[BATCH];
+static int32_t h_[BATCH];
+static int32_t hits_[BATCH];
+
+static bool expected_[BATCH];
+
+static long batches_ = 0;
+static double seconds_[3];  // aabb, aabb_batch, gjk
+
+static volatile uint32_t sink_ = 0;  // 讓編譯器保留被測的呼叫
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Roll one rectangle a and BATCH rectangles b.
+ *
+ *  @since  0.1.0
+ **/
+void fill_(void) {
+  extern Dice dice;
+
+  a_.x = (int)dice.roll(FIELD);
+  a_.y = (int)dice.roll(FIELD);
+  a_.w = 1 + (int)dice.roll(SIZE);
+  a_.h = 1 + (int)dice.roll(SIZE);
+
+  for (int i = 0; i < BATCH; ++i) {
+    x_[i] = (int32_t)dice.roll(FIELD);
+    y_[i] = (int32_t)dice.roll(FIELD);
+    w_[i] = 1 + (int32_t)dice.roll(SIZE);
+    h_[i] = 1 + (int32_t)dice.roll(SIZE);
+  }  // od
+}  // fill_()
+
+/**
+ *  Monotonic time in seconds.
+ *
+ *  @since  0.1.0
+ **/
+double now_(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}  // now_()
+
+/**
+ *  Check the three paths against each other on the current batch.
+ *
+ *  @param long * where to add the pairs that disagree and must not.
+ *  @param long * where to add the pairs in zero-area contact that
+ *         gjk reports differently.
+ *  @since  0.1.0
+ **/
+void check_(long *failures, long *touching) {
+  extern Collide collide;
+
+  int count = collide.aabb_batch(&a_, x_, y_, w_, h_, BATCH, hits_);
+  int k = 0;
+
+  for (int i = 0; i < BATCH; ++i) {
+    Rect b = {x_[i], y_[i], w_[i], h_[i]};
+
+    expected_[i] = collide.aabb(&a_, &b);
+  }  // od
+
+  // batch 的結果須與 aabb 完全一致
+  for (int i = 0; i < BATCH; ++i) {
+    bool hit = (k < count) && (hits_[k] == i);
+
+    k += hit ? 1 : 0;
+
+    if (hit != expected_[i]) {
+      printf("Fuzz: aabb_batch %s {%d %d %d %d} {%d %d %d %d}\n",
+             hit ? "hits" : "misses", a_.x, a_.y, a_.w, a_.h, x_[i], y_[i],
+             w_[i], h_[i]);
+      *failures += 1;
+    }  // fi
+  }    // od
+
+  for (int i = 0; i < BATCH; ++i) {
+    Collider a = {COLLIDER_AABB, a_, 0, (Point const *)NULL};
+    Collider b = {COLLIDER_AABB, {x_[i], y_[i], w_[i], h_[i]}, 0,
+                  (Point const *)NULL};
+
+    int ox = ((a_.x + a_.w < x_[i] + w_[i]) ? a_.x + a_.w : x_[i] + w_[i]) -
+             ((a_.x > x_[i]) ? a_.x : x_[i]);
+    int oy = ((a_.y + a_.h < y_[i] + h_[i]) ? a_.y + a_.h : y_[i] + h_[i]) -
+             ((a_.y > y_[i]) ? a_.y : y_[i]);
+
+    if (collide.gjk(&a, &b) == expected_[i]) {
+      continue;
+    }  // fi
+
+    // 只有邊或角相接 (重疊面積為零) 時允許不一致
+    if (((ox == 0) && (oy >= 0)) || ((oy == 0) && (ox >= 0))) {
+      *touching += 1;
+    }  // fi
+    else {
+      printf("Fuzz: gjk and aabb differ on {%d %d %d %d} {%d %d %d %d}\n",
+             a_.x, a_.y, a_.w, a_.h, x_[i], y_[i], w_[i], h_[i]);
+      *failures += 1;
+    }  // esle
+  }    // od
+}  // check_()
+
+/**
+ *  Time each path over the current batch.
+ *
+ *  @since  0.1.0
+ **/
+void time_(void) {
+  extern Collide collide;
+
+  uint32_t hits = 0;
+  double start = now_();
+
+  for (int i = 0; i < BATCH; ++i) {
+    Rect b = {x_[i], y_[i], w_[i], h_[i]};
+
+    hits += collide.aabb(&a_, &b);
+  }  // od
+
+  seconds_[0] += now_() - start;
+  start = now_();
+
+  hits += (uint32_t)collide.aabb_batch(&a_, x_, y_, w_, h_, BATCH, hits_);
+
+  seconds_[1] += now_() - start;
+  start = now_();
+
+  for (int i = 0; i < BATCH; ++i) {
+    Collider a = {COLLIDER_AABB, a_, 0, (Point const *)NULL};
+    Collider b = {COLLIDER_AABB, {x_[i], y_[i], w_[i], h_[i]}, 0,
+                  (Point const *)NULL};
+
+    hits += collide.gjk(&a, &b);
+  }  // od
+
+  seconds_[2] += now_() - start;
+  batches_ += 1;
+
+  sink_ += hits;
+}  // time_()
+
+/**
+ *  usage: fuzz [pairs] [seed]
+ *
+ *  @return int 0, or 1 when the paths disagree outside zero-area
+ *          contact.
+ *  @since  0.1.0
+ **/
+int main(int argc, char *argv[]) {
+  extern Dice dice;
+
+  static char const *const NAMES[] = {"aabb", "aabb_batch", "gjk"};
+
+  long pairs = (argc > 1) ? atol(argv[1]) : 2000000;
+  uint64_t seed = (argc > 2) ? strtoull(argv[2], (char **)NULL, 10) : 1;
+
+  long failures = 0;
+  long touching = 0;
+
+  dice.seed(seed);
+
+  for (long done = 0; done < pairs; done += BATCH) {
+    fill_();
+    check_(&failures, &touching);
+    time_();
+  }  // od
+
+  printf("%ld pairs, seed %llu\n", batches_ * BATCH,
+         (unsigned long long)seed);
+  printf("%ld in zero-area contact reported differently by gjk\n",
+         touching);
+  printf("%ld mismatches\n\n", failures);
+
+  printf("%-12s %14s\n", "path", "pairs/s");
+
+  for (int k = 0; k < 3; ++k) {
+    printf("%-12s %14.0f\n", NAMES[k], batches_ * BATCH / seconds_[k]);
+  }  // od
+
+  return (failures > 0) ? 1 : 0;
+}  // main()
+
+// fuzz.c
@@ -0,0 +1,297 @@
+/**
+ *  @file       scaling.c
+ *  @brief      Measures how the job system scales with the thread count.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The scaling benchmark.  Steps a large synthetic meteor field and
+ *  laser volley the way the game does (parallel integration, grid
+ *  rebuild, parallel swept laser queries) with 1 to N workers, and
+ *  reports the time per tick and the speedup over one worker.  The
+ *  hits must not depend on the worker count.
+ **/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL2/SDL.h>
+
+#include "collide.h"
+#include "grid.h"
+#include "jobs.h"
+#include "meteor.h"
+
+#define WIDTH 1920
+#define HEIGHT 1080
+#define CHUNK 1024
+#define GRAIN 64
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static void seed_(int, int);
+static void integrate_range_(void *, int, int, int);
+static void query_range_(void *, int, int, int);
+static uint32_t run_(int, int, double *);
+
+// 內部資料欄位 (private data) 宣告
+static MeteorStore meteors_;
+static Grid grid_;
+static Rect *lasers_ = (Rect *)NULL;
+static int lasers_count_ = 0;
+static int32_t *tally_ = (int32_t *)NULL;
+static int32_t *hit_ = (int32_t *)NULL;
+static GridMarks marks_[JOBS_MAX_WORKERS];
+static int32_t *candidates_[JOBS_MAX_WORKERS];
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Reset the meteors and lasers to the same pseudo-random start.
+ *
+ *  @since  0.1.0
+ **/
+void seed_(int meteors, int lasers) {
+  srand(1);
+
+  for (int i = 0; i < meteors; ++i) {
+    meteors_.x_[i] = rand() % WIDTH;
+    meteors_.y_[i] = rand() % HEIGHT;
+    meteors_.w_[i] = 20 + rand() % 80;
+    meteors_.h_[i] = 20 + rand() % 80;
+    meteors_.vx_[i] = rand() % 5 - 2;
+    meteors_.vy_[i] = rand() % 3 + 1;
+    meteors_.flags_[i] = METEOR_VISIBLE;
+  }  // od
+
+  for (int j = 0; j < lasers; ++j) {
+    lasers_[j].x = rand() % WIDTH;
+    lasers_[j].y = rand() % HEIGHT;
+    lasers_[j].w = 9;
+    lasers_[j].h = 54;
+  }  // od
+
+  lasers_count_ = lasers;
+}  // seed_()
+
+/**
+ *  Integrate the meteor chunks [begin, end).
+ *
+ *  @since  0.1.0
+ **/
+void integrate_range_(void *context, int begin, int end, int worker) {
+  extern MeteorKernel meteor_kernel;
+
+  (void)context;
+  (void)worker;
+
+  for (int k = begin; k < end; ++k) {
+    int first = k * CHUNK;
+    int last =
+        (first + CHUNK < meteors_.count_) ? first + CHUNK : meteors_.count_;
+
+    tally_[k] =
+        meteor_kernel.integrate_range(&meteors_, first, last, WIDTH, HEIGHT);
+  }  // od
+}  // integrate_range_()
+
+/**
+ *  Sweep the lasers [begin, end) up the screen and record the first
+ *  meteor each one hits.
+ *
+ *  @since  0.1.0
+ **/
+void query_range_(void *context, int begin, int end, int worker) {
+  extern Collide collide;
+  extern GridIndex grid_index;
+
+  Point move = {0, -30};
+  Point drift;
+  Rect box;
+
+  (void)context;
+
+  for (int j = begin; j < end; ++j) {
+    Rect *laser = &lasers_[j];
+    int32_t *candidate = candidates_[worker];
+    float first = 2.0f;
+
+    int n = grid_index.search(&grid_, &marks_[worker], laser->x,
+                              laser->y + move.y, laser->w,
+                              laser->h - move.y, candidate);
+
+    hit_[j] = -1;
+
+    for (int k = 0; k < n; ++k) {
+      int i = candidate[k];
+      float toi = 0.0f;
+
+      box.x = meteors_.x_[i] - meteors_.vx_[i];
+      box.y = meteors_.y_[i] - meteors_.vy_[i];
+      box.w = meteors_.w_[i];
+      box.h = meteors_.h_[i];
+      drift.x = meteors_.vx_[i];
+      drift.y = meteors_.vy_[i];
+
+      if (collide.sweep(laser, (Bitmask const *)NULL, &move, &box,
+                        (Bitmask const *)NULL, &drift, &toi) &&
+          toi < first) {
+        first = toi;
+        hit_[j] = i;
+      }  // fi
+    }    // od
+  }      // od
+}  // query_range_()
+
+/**
+ *  Run `ticks` ticks with `workers` workers.
+ *
+ *  @param int number of workers.
+ *  @param int number of ticks.
+ *  @param double * the milliseconds per tick.
+ *  @return uint32_t a hash of the culls and hits, for comparing runs.
+ *  @since  0.1.0
+ **/
+uint32_t run_(int workers, int ticks, double *ms) {
+  extern GridIndex grid_index;
+  extern JobSystem job_system;
+
+  int chunks = (meteors_.count_ + CHUNK - 1) / CHUNK;
+  uint32_t hash = 2166136261u;
+  Uint64 start = 0;
+
+  job_system.init(workers);
+
+  for (int w = 0; w < job_system.workers(); ++w) {
+    grid_index.marks_init(&marks_[w]);
+    candidates_[w] = (int32_t *)malloc(sizeof(int32_t) * meteors_.count_);
+  }  // od
+
+  seed_(meteors_.count_, lasers_count_);
+
+  start = SDL_GetPerformanceCounter();
+
+  for (int t = 0; t < ticks; ++t) {
+    int culls = 0;
+
+    job_system.parallel_for(chunks, 1, integrate_range_, (void *)NULL);
+
+    for (int k = 0; k < chunks; ++k) {
+      memmove(meteors_.culled_ + culls, meteors_.culled_ + k * CHUNK,
+              sizeof(int32_t) * tally_[k]);
+      culls += tally_[k];
+    }  // od
+
+    // 離開畫面的隕石從上方重來
+    for (int k = 0; k < culls; ++k) {
+      int i = meteors_.culled_[k];
+
+      meteors_.y_[i] = -meteors_.h_[i];
+      meteors_.x_[i] = (i * 7919) % WIDTH;
+
+      hash = (hash ^ (uint32_t)i) * 16777619u;
+    }  // od
+
+    grid_index.build(&grid_, &meteors_);
+
+    job_system.parallel_for(lasers_count_, GRAIN, query_range_,
+                            (void *)NULL);
+
+    for (int j = 0; j < lasers_count_; ++j) {
+      hash = (hash ^ (uint32_t)hit_[j]) * 16777619u;
+    }  // od
+  }    // od
+
+  *ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 /
+        (double)SDL_GetPerformanceFrequency() / ticks;
+
+  for (int w = 0; w < job_system.workers(); ++w) {
+    grid_index.marks_release(&marks_[w]);
+    free(candidates_[w]);
+  }  // od
+
+  job_system.release();
+
+  return hash;
+}  // run_()
+
+/**
+ *  usage: scaling [meteors] [lasers] [ticks] [max-workers]
+ *
+ *  @since  0.1.0
+ **/
+int main(int argc, char *argv[]) {
+  extern GridIndex grid_index;
+  extern MeteorKernel meteor_kernel;
+
+  int meteors = (argc > 1) ? atoi(argv[1]) : 20000;
+  int lasers = (argc > 2) ? atoi(argv[2]) : 4096;
+  int ticks = (argc > 3) ? atoi(argv[3]) : 100;
+  int workers = (argc > 4) ? atoi(argv[4]) : SDL_GetCPUCount();
+
+  double base = 0.0;
+  uint32_t expected = 0;
+
+  meteor_kernel.alloc(&meteors_, meteors);
+  grid_index.init(&grid_, WIDTH, HEIGHT, 128, 96);
+
+  lasers_ = (Rect *)malloc(sizeof(Rect) * lasers);
+  lasers_count_ = lasers;
+  hit_ = (int32_t *)malloc(sizeof(int32_t) * lasers);
+  tally_ = (int32_t *)malloc(sizeof(int32_t) * (meteors / CHUNK + 1));
+
+  printf("%d meteors, %d lasers, %d ticks\n", meteors, lasers, ticks);
+  printf("workers  ms/tick  speedup\n");
+
+  for (int w = 1; w <= workers; ++w) {
+    double ms = 0.0;
+    uint32_t hash = run_(w, ticks, &ms);
+
+    if (w == 1) {
+      base = ms;
+      expected = hash;
+    }  // fi
+
+    printf("%7d  %7.3f  %6.2fx%s\n", w, ms, base / ms,
+           (hash == expected) ? "" : "  MISMATCH");
+  }  // od
+
+  free(tally_);
+  free(hit_);
+  free(lasers_);
+  grid_index.release(&grid_);
+  meteor_kernel.release(&meteors_);
+
+  return 0;
+}  // main()
+
+// scaling.c
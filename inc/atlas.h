@@ -0,0 +1,82 @@
+/**
+ *  @file       atlas.h
+ *  @brief      The atlas file's header information.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The atlas header file.  Sprites are packed into a few large
+ *  texture pages at startup so rendering rarely switches textures.
+ **/
+
+#ifndef UXI_ATLAS_H
+#define UXI_ATLAS_H
+
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+
+#include "game.h"
+
+#define ATLAS_PAGE_SIZE 1024
+#define ATLAS_PAGES 4
+
+/**
+ *  One atlas page.  Images are packed on shelves (rows) left to
+ *  right; each is surrounded by a 1-pixel border copied from its own
+ *  edge pixels, so linear filtering never samples a neighbour.
+ **/
+typedef struct {
+  int w_;
+  int h_;
+
+  int shelf_x_;
+  int shelf_y_;
+  int shelf_h_;
+
+  int count_;
+  int capacity_;
+  Sprite** sprites_;  // sprites whose pixels live on this page
+
+  SDL_Surface* surface_;
+  SDL_Texture* texture_;
+} Atlas;
+
+typedef struct {
+  void (*open)(Atlas*, int, int);
+  bool (*pack)(Atlas*, Sprite*, SDL_Surface*);
+  bool (*bake)(Atlas*, SDL_Renderer*);
+  void (*close)(Atlas*);
+} AtlasPacker;
+
+#endif  // UXI_ATLAS_H
+
+// atlas.h
@@ -0,0 +1,78 @@
+/**
+ *  @file       batch.h
+ *  @brief      The batch file's header information.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The batch header file.  A sprite batcher which turns runs of
+ *  textured quads into single SDL_RenderGeometry() calls.
+ **/
+
+#ifndef UXI_BATCH_H
+#define UXI_BATCH_H
+
+#include <SDL2/SDL.h>
+
+#define BATCH_CAPACITY 4096
+
+/**
+ *  Quads are queued in submission order.  Consecutive quads sharing
+ *  a texture and blend mode form one draw call; a change of either,
+ *  a full buffer or an explicit flush() submits the queued run.
+ **/
+typedef struct {
+  int count_;
+  int capacity_;
+  int calls_;  // draw calls issued since the last reset
+
+  int tex_w_;
+  int tex_h_;
+
+  SDL_Renderer* renderer_;
+  SDL_Texture* texture_;
+  SDL_BlendMode blend_;
+
+  SDL_Vertex* vertices_;
+  int* indices_;
+} SpriteBatch;
+
+typedef struct {
+  void (*init)(SpriteBatch*, SDL_Renderer*, int);
+  void (*release)(SpriteBatch*);
+  void (*draw)(SpriteBatch*, SDL_Texture*, SDL_BlendMode, SDL_Rect const*,
+               SDL_Rect const*);
+  void (*flush)(SpriteBatch*);
+} SpriteBatcher;
+
+#endif  // UXI_BATCH_H
+
+// batch.h
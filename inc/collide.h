@@ -0,0 +1,108 @@
+/**
+ *  @file       collide.h
+ *  @brief      The collide file's header information.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The collide header file.  The narrowphase of the collision
+ *  detection: an AABB test for rectangles and GJK for general convex
+ *  colliders.
+ **/
+
+#ifndef UXI_COLLIDE_H
+#define UXI_COLLIDE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ *  A point and an axis-aligned rectangle.  They lay out like SDL_Point
+ *  and SDL_Rect, but the collision code (and the simulation built on
+ *  it) does not depend on SDL.
+ **/
+typedef struct {
+  int x;
+  int y;
+} Point;
+
+typedef struct {
+  int x;
+  int y;
+  int w;
+  int h;
+} Rect;
+
+typedef enum { COLLIDER_AABB, COLLIDER_POLYGON } ColliderKind;
+
+/**
+ *  A convex collider.  `box_` is the bounding box; for polygons the
+ *  `count_` vertices in `points_` are given in world coordinates.
+ **/
+typedef struct {
+  ColliderKind kind_;
+
+  Rect box_;
+
+  int count_;
+  Point const* points_;
+} Collider;
+
+/**
+ *  A packed 1-bit-per-pixel mask.  Each row takes `words_` 64-bit
+ *  words; pixel x of row y is bit (x % 64) of word (y * words_ + x / 64).
+ **/
+typedef struct {
+  int w_;
+  int h_;
+  int words_;
+
+  uint64_t* bits_;
+} Bitmask;
+
+typedef struct {
+  bool (*aabb)(Rect const*, Rect const*);
+  int (*aabb_batch)(Rect const*, int32_t const*, int32_t const*,
+                    int32_t const*, int32_t const*, int, int32_t*);
+  bool (*gjk)(Collider const*, Collider const*);
+  bool (*test)(Collider const*, Collider const*);
+
+  void (*mask_alloc)(Bitmask*, int, int);
+  void (*mask_release)(Bitmask*);
+  bool (*masks)(Rect const*, Bitmask const*, Rect const*,
+                Bitmask const*);
+  bool (*sweep)(Rect const*, Bitmask const*, Point const*,
+                Rect const*, Bitmask const*, Point const*, float*);
+} Collide;
+
+#endif  // UXI_COLLIDE_H
+
+// collide.h
@@ -33,7 +33,8 @@
  *
  *  @section DESCRIPTION
  *
- *  The dice header file.
+ *  The dice header file.  Dice rolls come from seedable xoshiro256**
+ *  streams; the rolls of a stream only depend on its seed.
  **/
 
 #ifndef UXI_DICE_H
@@ -41,7 +42,23 @@
 
 #include <stdint.h>
 
-typedef struct { uint32_t (*roll)(uint32_t); } Dice;
+/**
+ *  State of one xoshiro256** generator.  Streams made by Dice::stream
+ *  from the same seed do not overlap, so each thread can own one.
+ **/
+typedef struct {
+  uint64_t s_[4];
+} DiceStream;
+
+typedef struct {
+  uint32_t (*roll)(uint32_t);
+  void (*fill)(uint32_t, uint32_t*, int);
+  void (*seed)(uint64_t);
+  void (*stream)(DiceStream*, int);
+  uint32_t (*roll_with)(DiceStream*, uint32_t);
+  void (*fill_with)(DiceStream*, uint32_t, uint32_t*, int);
+  void (*seed_with)(DiceStream*, uint64_t);
+} Dice;
 
 #endif  // UXI_DICE_H
 
@@ -0,0 +1,128 @@
+/**
+ *  @file       env.h
+ *  @brief      The env file's header information.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The batch environment header file.  An EnvBatch steps many
+ *  independent worlds in lockstep, one Input each, and writes every
+ *  world's reward, done flag and observation into buffers the caller
+ *  owns.  A world that is done starts its next episode right away, so
+ *  the batch never stops.  It lives in libloaded_sim.a: the threads come
+ *  from the host's parallel_for, as for a single World.
+ **/
+
+#ifndef UXI_ENV_H
+#define UXI_ENV_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sim.h"
+
+#define ENV_GRAIN 8    // 每個工作的 world 數
+#define ENV_LASERS 64  // 每個 world 預設的 laser pool 容量
+#define ENV_NEAREST_MAX 32
+
+// 實體觀測: 戰機 4 個值, 每顆最近的隕石 5 個值
+#define ENV_SHIP_FLOATS 4    // x, y, health, lives
+#define ENV_METEOR_FLOATS 5  // present, dx, dy, vx, vy
+
+// 佔據格的位元
+#define ENV_CELL_METEOR 0x01
+#define ENV_CELL_LASER 0x02
+#define ENV_CELL_SHIP 0x04
+
+// 每一步的獎勵
+#define ENV_REWARD_KILL 1.0f    // 擊落一顆隕石
+#define ENV_REWARD_HIT -0.1f    // 戰機每受 1 點傷害
+#define ENV_REWARD_DEAD -10.0f  // 失去最後一架戰機
+
+/**
+ *  What a batch is made from.  Every world is made from `world_`;
+ *  world i's k-th episode is seeded with
+ *  `world_.seed_ + k * count_ + i`, so no two episodes of a batch
+ *  share a seed and the batch replays exactly.
+ **/
+typedef struct {
+  int count_;      // number of worlds
+  int max_ticks_;  // an episode ends after this many ticks, 0: never
+  int nearest_;    // meteors in an entity observation
+  int grid_w_;     // occupancy grid, cells across
+  int grid_h_;     // occupancy grid, cells down
+
+  WorldConfig world_;  // lasers_ 0: ENV_LASERS
+} EnvConfig;
+
+/**
+ *  Caller-owned buffers a reset or a step writes into.  Either
+ *  observation may be NULL and is then not computed.
+ *
+ *  `entities_` holds `vec_env.entity_floats()` floats per world: the
+ *  ship (x, y over the scene size, health over 100, lives), then the
+ *  `nearest_` visible meteors nearest the ship, nearest first
+ *  (present, dx, dy over the scene size, vx, vy in ship steps per
+ *  tick); missing meteors are all 0.
+ *
+ *  `grid_` holds `grid_w_ * grid_h_` cells per world, row by row,
+ *  each an ENV_CELL_* mask of what covers it.
+ **/
+typedef struct {
+  float* reward_;    // count_
+  uint8_t* done_;    // count_
+  float* entities_;  // count_ * entity_floats(), or NULL
+  uint8_t* grid_;    // count_ * grid_w_ * grid_h_, or NULL
+} EnvOutput;
+
+typedef struct {
+  EnvConfig config_;
+  WorldHooks hooks_;  // parallel_for 用於分配 world 給各執行緒
+
+  World* worlds_;       // count_ worlds, contiguous
+  uint32_t* episodes_;  // per world, the episode it plays
+
+  // 一次 step 的參數, 供各執行緒讀取
+  Input const* actions_;
+  EnvOutput const* out_;
+} EnvBatch;
+
+typedef struct {
+  void (*init)(EnvBatch*, EnvConfig const*, WorldHooks const*);
+  void (*release)(EnvBatch*);
+  void (*reset)(EnvBatch*, EnvOutput const*);
+  void (*step)(EnvBatch*, Input const*, EnvOutput const*);
+  int (*entity_floats)(EnvBatch const*);
+} VecEnv;
+
+#endif  // UXI_ENV_H
+
+// env.h
@@ -43,90 +43,50 @@
 
 #include <SDL2/SDL.h>
 
-typedef struct {
-  char* name_;
-
-  SDL_Rect rect_;
-  SDL_Texture* texture_;
-} Sprite;
-
-typedef struct Laser {
-  bool body_enable;
-  bool exploding;
-  int exploding_idx;
-  bool visible_;
-
-  int velocity_;
-
-  int idx;
-
-  SDL_Rect box_;
-
-  Sprite* sprite_;
-
-  struct Laser* next_;
-} Laser;
+#include "collide.h"
+#include "sim.h"
 
 typedef struct {
-  bool visible_;
-
-  int velocity_;
-
-  int velocitx_;
+  char* name_;
 
-  SDL_Rect box_;
+  SDL_Rect rect_;         // source rect inside the atlas page
+  SDL_Texture* texture_;  // the atlas page, shared with other sprites
 
-  Sprite* sprite_;
-} Meteor;
+  Bitmask mask_;  // 1-bit alpha mask, for pixel-accurate collision
+} Sprite;
 
 typedef struct {
   Laser* lasers_;
-  Meteor* meteors_;
 } RecycleBin;
 
 typedef struct {
-  char* name_;
-
-  int obj_counts_;
-  int sprite_counts_;
-
-  SDL_Rect box_;
+  int count_;
 
-  Laser* lasers_;
-  Meteor* meteors_;
-  Sprite* sprite_;
-  Sprite** meteor_sprites_;
-} Scene;
+  Wings* wings;
+} Swarm;
 
+/**
+ *  The sprites the world is drawn with.  The world itself only sees
+ *  their sizes and masks (Shape).
+ **/
 typedef struct {
-  bool alive;
-  int health;
-  int num_life;
-  Uint32 shot_laser_next_time;
-
-  SDL_Point position_;
+  int meteor_counts_;
 
-  SDL_Rect hitbox_[2];
-
-  Sprite* laser_sprites_[11];
+  Sprite* background_;
+  Sprite* meteors_[SIM_METEOR_KINDS];
+  Sprite* ship_;
   Sprite* damages_[3];
   Sprite* fire_[8];
-  Sprite* sprite_;
-} Wings;
-
-typedef struct {
-  int count_;
-
-  Wings* wings;
-} Swarm;
+  Sprite* lasers_[LASER_FRAMES];
+} Skin;
 
 typedef struct {
   void (*init)(void);
   void (*over)(void);
   void (*start)(void);
 
-  Wings* wings;
-  Scene* scene;
+  World* world;
+  Skin* skin;
 } Game;
 
 #endif  // UXI_GAME_H
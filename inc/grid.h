@@ -0,0 +1,99 @@
+/**
+ *  @file       grid.h
+ *  @brief      The grid file's header information.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The grid header file.  A uniform grid over the scene used as the
+ *  broadphase of the collision detection.
+ **/
+
+#ifndef UXI_GRID_H
+#define UXI_GRID_H
+
+#include <stdint.h>
+
+#include "meteor.h"
+
+/**
+ *  Per-query scratch which de-duplicates the meteors a query finds
+ *  in several cells.  Queries sharing a GridMarks must not overlap,
+ *  so concurrent queries need one each.
+ **/
+typedef struct {
+  int meteors_;  // size of stamp_
+  uint32_t epoch_;
+  uint32_t* stamp_;  // per meteor, the last epoch it was collected
+} GridMarks;
+
+/**
+ *  Uniform grid stored in compressed-row form: the meteors of cell c
+ *  are `items_[start_[c]]` up to (but excluding) `items_[start_[c + 1]]`.
+ *  A meteor is listed in every cell its swept box (the union of its
+ *  boxes at the start and the end of the tick) touches.
+ **/
+typedef struct {
+  int cols_;
+  int rows_;
+  int cell_w_;
+  int cell_h_;
+
+  int capacity_;
+  int meteors_;  // meteor count at the last build()
+
+  GridMarks marks_;  // used by gather()
+
+  int32_t* start_;
+  int32_t* items_;
+} Grid;
+
+typedef struct {
+  int col0_;
+  int row0_;
+  int col1_;
+  int row1_;
+} GridSpan;
+
+typedef struct {
+  void (*init)(Grid*, int, int, int, int);
+  void (*release)(Grid*);
+  void (*build)(Grid*, MeteorStore const*);
+  void (*span)(Grid const*, int, int, int, int, GridSpan*);
+  int (*gather)(Grid*, int, int, int, int, int32_t*);
+  int (*search)(Grid const*, GridMarks*, int, int, int, int, int32_t*);
+  void (*marks_init)(GridMarks*);
+  void (*marks_release)(GridMarks*);
+} GridIndex;
+
+#endif  // UXI_GRID_H
+
+// grid.h
@@ -0,0 +1,82 @@
+/**
+ *  @file       jobs.h
+ *  @brief      Declares the work-stealing job system.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The jobs header file.  A small work-stealing scheduler: each worker
+ *  owns a deque of index ranges, pops its own work from the bottom and
+ *  steals from the top of the others' when it runs dry.
+ **/
+
+#ifndef UXI_JOBS_H
+#define UXI_JOBS_H
+
+#include <SDL2/SDL.h>
+
+#define JOBS_MAX_WORKERS 64
+#define JOBS_DEQUE_CAPACITY 256
+
+/**
+ *  Body of a parallel_for(): process the indices [begin, end) on
+ *  worker `worker` (0 is the calling thread).  The worker index lets
+ *  the body pick per-worker scratch storage.
+ **/
+typedef void (*JobRange)(void* context, int begin, int end, int worker);
+
+typedef struct {
+  JobRange body_;
+  void* context_;
+
+  int begin_;
+  int end_;
+} Job;
+
+typedef struct {
+  SDL_SpinLock lock_;
+
+  int top_;     // thieves take from here
+  int bottom_;  // the owner pushes and pops here
+
+  Job jobs_[JOBS_DEQUE_CAPACITY];
+} JobDeque;
+
+typedef struct {
+  void (*init)(int);
+  void (*release)(void);
+  int (*workers)(void);
+  void (*parallel_for)(int, int, JobRange, void*);
+} JobSystem;
+
+#endif  // UXI_JOBS_H
+
+// jobs.h
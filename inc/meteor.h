@@ -0,0 +1,75 @@
+/**
+ *  @file       meteor.h
+ *  @brief      The meteor file's header information.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The meteor header file.  Meteors are stored as a structure of
+ *  arrays so the per-tick integration can run on SIMD lanes.
+ **/
+
+#ifndef UXI_METEOR_H
+#define UXI_METEOR_H
+
+#include <stdint.h>
+
+#define METEOR_VISIBLE 0x01
+
+typedef struct {
+  int count_;
+
+  int32_t* x_;
+  int32_t* y_;
+  int32_t* w_;
+  int32_t* h_;
+  int32_t* vx_;
+  int32_t* vy_;
+
+  uint8_t* flags_;
+  // meteor kind: index into WorldConfig::meteor_shapes_ in the
+  // simulation, and into Skin::meteors_ in the renderer
+  uint8_t* sprite_;
+
+  int32_t* culled_;  // scratch: indices left the scene this tick
+  int32_t* hits_;    // scratch: indices returned by batch queries
+} MeteorStore;
+
+typedef struct {
+  void (*alloc)(MeteorStore*, int);
+  void (*release)(MeteorStore*);
+  int (*integrate)(MeteorStore*, int32_t, int32_t);
+  int (*integrate_range)(MeteorStore*, int, int, int32_t, int32_t);
+} MeteorKernel;
+
+#endif  // UXI_METEOR_H
+
+// meteor.h
@@ -0,0 +1,76 @@
+/**
+ *  @file       options.h
+ *  @brief      The options file's header information.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The options header file.  Start-up options taken from the
+ *  command line.
+ **/
+
+#ifndef UXI_OPTIONS_H
+#define UXI_OPTIONS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+  void (*parse)(int, char*[]);
+
+  bool headless_;      // no window; render offscreen, if at all
+  bool render_;        // false: skip rendering entirely
+  bool vsync_;         // false: present frames as fast as possible
+  bool seeded_;        // seed_ given on the command line
+  bool fast_;          // simulate as fast as possible, even with a window
+  bool stress_;        // auto-fire along a scripted path, the ship never dies
+  bool share_frames_;  // export the rendered frames too, with share_
+
+  int width_;    // headless resolution
+  int height_;
+  int frames_;   // stop after this many ticks, 0 for no limit
+  int threads_;  // job system workers, 0 for one per CPU
+
+  int meteors_;    // 0 for one per 256 x 192 of the scene
+  int lasers_;     // live lasers at most, 0 for LASER_POOL_CAPACITY
+  int fire_rate_;  // lasers per second, 0 for one per 400 ms
+
+  uint64_t seed_;  // dice seed, when seeded_
+
+  char const* record_;  // record the session to this file
+  char const* replay_;  // play this recorded session back
+  char const* trace_;   // write a Chrome trace of the session here
+  char const* share_;   // export every tick to this shared memory object
+} Options;
+
+#endif  // UXI_OPTIONS_H
+
+// options.h
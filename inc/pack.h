@@ -0,0 +1,93 @@
+/**
+ *  @file       pack.h
+ *  @brief      The pack file's header information.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The asset pack header file.  A pack holds images already decoded to
+ *  RGBA32, baked at build time by tool/bake.c, so the game can map it
+ *  into memory instead of decoding PNGs at every launch.
+ **/
+
+#ifndef UXI_PACK_H
+#define UXI_PACK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <SDL2/SDL.h>
+
+#define PACK_MAGIC "LDPK"
+#define PACK_VERSION 2
+#define PACK_BYTE_ORDER 0x01020304u  // 以烘焙機的 byte order 寫入
+#define PACK_NAME_MAX 52  // 含結尾的 '\0'
+#define PACK_ALIGN 64     // 每張圖的像素資料對齊
+
+/**
+ *  The pack file starts with a PackHeader, followed by `count_`
+ *  PackEntry records sorted by name, followed by the pixels.  Both are
+ *  read straight from the mapping, so the file is in host byte order;
+ *  `byte_order_` holds PACK_BYTE_ORDER as the baking host wrote it, and
+ *  reads back swapped on a host of the other byte order.
+ **/
+typedef struct {
+  char magic_[4];
+  uint32_t version_;
+  uint32_t count_;
+  uint32_t byte_order_;
+} PackHeader;
+
+typedef struct {
+  char name_[PACK_NAME_MAX];  // 圖檔路徑, 如 "img/ship.png"
+  uint32_t width_;
+  uint32_t height_;
+  uint32_t offset_;  // 像素 (RGBA32, pitch = width * 4) 在檔案中的位置
+} PackEntry;
+
+typedef struct {
+  void* base_;  // the mapped file, NULL when no pack is open
+  size_t size_;
+
+  uint32_t count_;
+  PackEntry const* entries_;
+} Pack;
+
+typedef struct {
+  bool (*open)(Pack*, char const*);
+  SDL_Surface* (*surface)(Pack const*, char const*);
+  void (*close)(Pack*);
+} AssetPack;
+
+#endif  // UXI_PACK_H
+
+// pack.h
@@ -0,0 +1,129 @@
+/**
+ *  @file       profile.h
+ *  @brief      The profile file's header information.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The frame profiler header file.  Scoped timers around the phases of
+ *  a simulation tick and a rendered frame, kept in fixed ring buffers.
+ *  The profiler is built in only with UXI_PROFILE defined (the debug
+ *  build).  PROFILE_BEGIN() and PROFILE_END() also mark the phase in
+ *  the event trace when UXI_TRACE is defined, which UXI_PROFILE
+ *  implies; without either they expand to nothing.
+ **/
+
+#ifndef UXI_PROFILE_H
+#define UXI_PROFILE_H
+
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+
+#include "trace.h"
+
+#define PROFILE_SAMPLES 1024  // 每個 phase 保留的樣本數
+
+typedef enum {
+  PHASE_TICK,  // 整個模擬 tick
+  PHASE_UPDATE_LASERS,
+  PHASE_UPDATE_METEORS,
+  PHASE_COLLIDE_LASERS,
+  PHASE_COLLIDE_WINGS,
+  PHASE_FRAME,  // 整個畫面
+  PHASE_UPDATE_SCENE,
+  PHASE_PRESENT,
+  PHASE_COUNT
+} Phase;
+
+/**
+ *  The last PROFILE_SAMPLES timings of one phase.  Each phase is
+ *  timed on one thread only; the lock guards readers on the other.
+ **/
+typedef struct {
+  SDL_SpinLock lock_;
+  Uint32 count_;  // samples recorded so far, the ring wraps
+  Uint32 index_[PROFILE_SAMPLES];  // tick or frame number
+  Uint32 usec_[PROFILE_SAMPLES];
+} ProfileRing;
+
+typedef struct {
+  Uint32 count_;
+  float min_;  // ms
+  float avg_;
+  float p99_;
+} ProfileStats;
+
+typedef struct {
+  char const* (*name)(Phase);
+  void (*record)(Phase, Uint32, Uint64);
+  void (*stats)(Phase, ProfileStats*);
+  void (*toggle)(void);
+  void (*draw)(SDL_Renderer*);
+  void (*report)(void);
+  bool (*dump)(char const*);
+} Profiler;
+
+extern Profiler profiler;
+extern Trace trace;
+
+// debug 版的 phase 一定記入 event trace; release 版以 UXI_TRACE 編譯才記
+#if defined(UXI_PROFILE) && !defined(UXI_TRACE)
+#define UXI_TRACE
+#endif
+
+#ifdef UXI_TRACE
+#define PROFILE_MARK_BEGIN(phase) trace.begin(profiler.name(phase))
+#define PROFILE_MARK_END(phase) trace.end(profiler.name(phase))
+#else
+#define PROFILE_MARK_BEGIN(phase)
+#define PROFILE_MARK_END(phase)
+#endif
+
+// 以 SDL 的高解析度計數器計時 phase; index 為 tick 或 frame 編號
+#ifdef UXI_PROFILE
+#define PROFILE_BEGIN(phase)                             \
+  Uint64 const phase##_at = SDL_GetPerformanceCounter(); \
+  PROFILE_MARK_BEGIN(phase)
+#define PROFILE_END(phase, index) \
+  PROFILE_MARK_END(phase);        \
+  profiler.record(phase, index, phase##_at)
+#elif defined(UXI_TRACE)
+#define PROFILE_BEGIN(phase) PROFILE_MARK_BEGIN(phase)
+#define PROFILE_END(phase, index) PROFILE_MARK_END(phase)
+#else
+#define PROFILE_BEGIN(phase)
+#define PROFILE_END(phase, index)
+#endif
+
+#endif  // UXI_PROFILE_H
+
+// profile.h
@@ -0,0 +1,75 @@
+/**
+ *  @file       registry.h
+ *  @brief      The registry file's header information.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The sprite registry header file.  Sprites are registered by their
+ *  image path, so an image requested twice is loaded once and shared.
+ **/
+
+#ifndef UXI_REGISTRY_H
+#define UXI_REGISTRY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "game.h"
+
+/**
+ *  An open-addressing (linear probing) hash map from image path to
+ *  Sprite, with a reference count per entry.
+ **/
+typedef struct {
+  Sprite* sprite_;  // NULL for an empty slot
+  uint32_t hash_;
+  int refs_;
+} RegistrySlot;
+
+typedef struct {
+  int capacity_;  // a power of two, kept at most half full
+  int count_;
+  RegistrySlot* slots_;
+} Registry;
+
+typedef struct {
+  void (*init)(Registry*, int);
+  Sprite* (*acquire)(Registry*, char const*, bool*);
+  void (*release)(Registry*, Sprite*);
+  void (*clear)(Registry*);
+  size_t (*texture_bytes)(Registry const*);
+} SpriteRegistry;
+
+#endif  // UXI_REGISTRY_H
+
+// registry.h
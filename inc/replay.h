@@ -0,0 +1,81 @@
+/**
+ *  @file       replay.h
+ *  @brief      Declares the input recording and replay file.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The replay header file.  A replay holds the dice seed, the scene
+ *  size and, for every simulation tick, the player's input and a hash
+ *  of the resulting state, so a recorded session can be played back
+ *  and checked tick by tick.
+ **/
+
+#ifndef UXI_REPLAY_H
+#define UXI_REPLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "sim.h"
+
+#define REPLAY_VERSION 3  // 模擬的結果改變時加一, 舊的錄影不再相符
+
+typedef struct {
+  FILE* file_;
+  bool writing_;
+
+  // 開始錄製前設定, 播放時由檔案讀入
+  uint64_t seed_;
+  int32_t width_;  // scene size, the meteor layout depends on it
+  int32_t height_;
+
+  // 同名的 Options 欄位: 隕石數, laser 數與射速, stress 模式
+  int32_t meteors_;
+  int32_t lasers_;
+  int32_t fire_rate_;
+  bool stress_;
+
+  uint32_t ticks_;  // ticks written, or stored in the file
+} Replay;
+
+typedef struct {
+  bool (*create)(Replay*, char const*);
+  bool (*open)(Replay*, char const*);
+  void (*write)(Replay*, Input const*, uint32_t);
+  bool (*read)(Replay*, Input*, uint32_t*);
+  void (*close)(Replay*);
+} ReplayFile;
+
+#endif  // UXI_REPLAY_H
+
+// replay.h
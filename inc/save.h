@@ -0,0 +1,70 @@
+/**
+ *  @file       save.h
+ *  @brief      The save file's header information.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The world save header file.  A save is a flat, versioned blob of a
+ *  World's state without pointers: meteor kinds and laser frames are
+ *  indices, meteors and lasers are stored as arrays.  Only the shapes
+ *  (sizes and masks) are not saved; they belong to the host that made
+ *  the world.  A delta encodes a save against an earlier one of the same
+ *  world, for rollback buffers and replays.
+ **/
+
+#ifndef UXI_SAVE_H
+#define UXI_SAVE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sim.h"
+
+#define SAVE_VERSION 1
+#define SAVE_HEADER_SIZE 148  // bytes before the meteor arrays
+#define DELTA_HEADER_SIZE 20
+
+typedef struct {
+  size_t (*bound)(World const*);
+  size_t (*save)(World const*, uint8_t*, size_t);
+  bool (*load)(World*, uint8_t const*, size_t);
+  bool (*config)(uint8_t const*, size_t, WorldConfig*);
+  size_t (*delta)(uint8_t const*, size_t, uint8_t const*, size_t, uint8_t*,
+                  size_t);
+  size_t (*patch)(uint8_t const*, size_t, uint8_t const*, size_t, uint8_t*,
+                  size_t);
+} WorldSaver;
+
+#endif  // UXI_SAVE_H
+
+// save.h
@@ -0,0 +1,160 @@
+/**
+ *  @file       shm.h
+ *  @brief      The shm file's header information.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The shared memory export header file.  The game publishes the
+ *  entity state of every tick, and optionally each rendered frame, into
+ *  a POSIX shared memory object (/dev/shm) laid out as below, so local
+ *  tools read them in place: no copies, no syscalls, no socket.
+ *
+ *  The object starts with a ShmHeader, followed by SHM_SLOTS state slots
+ *  of state_size_ bytes, then SHM_SLOTS frame slots of frame_size_ bytes.
+ *  Each slot is a seqlock: the writer makes seq_ odd, writes, and makes
+ *  it even again, then stores the slot's generation in the header's
+ *  latest counter (slot = generation % SHM_SLOTS).  The writer never
+ *  waits for readers; a reader whose seq_ changed under it reads the
+ *  newest slot again.
+ **/
+
+#ifndef UXI_SHM_H
+#define UXI_SHM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <SDL2/SDL.h>
+
+#include "sim.h"
+
+#define SHM_MAGIC 0x314d4853u  // "SHM1"
+#define SHM_VERSION 1
+#define SHM_SLOTS 4
+#define SHM_NAME_MAX 64
+
+#define SHM_LASER 0x01  // the entity is a laser, else a meteor
+
+/**
+ *  A meteor or a laser, as published.  Lasers follow the meteors.
+ **/
+typedef struct {
+  int32_t x_;
+  int32_t y_;
+  int32_t w_;
+  int32_t h_;
+  int32_t vx_;  // movement per tick
+  int32_t vy_;
+
+  uint8_t kind_;   // meteor kind, or laser animation frame
+  uint8_t flags_;  // SHM_LASER
+  uint16_t reserved_;
+} ShmEntity;
+
+/**
+ *  One tick of the world; meteor_count_ + laser_count_ ShmEntity
+ *  follow it in the slot.
+ **/
+typedef struct {
+  SDL_atomic_t seq_;  // odd while the slot is written
+
+  uint32_t tick_;
+
+  int32_t ship_x_;
+  int32_t ship_y_;
+  int32_t health_;
+  int32_t lives_;
+  int32_t alive_;
+
+  uint32_t meteor_count_;  // visible meteors only
+  uint32_t laser_count_;
+} ShmState;
+
+/**
+ *  One rendered frame, ARGB8888; h_ rows of pitch_ bytes follow it in
+ *  the slot.
+ **/
+typedef struct {
+  SDL_atomic_t seq_;  // odd while the slot is written
+
+  uint32_t tick_;  // the tick the frame shows
+
+  int32_t w_;
+  int32_t h_;
+  int32_t pitch_;
+} ShmFrame;
+
+typedef struct {
+  uint32_t magic_;
+  uint32_t version_;
+  uint32_t slots_;
+
+  uint32_t max_entities_;  // per state slot
+  uint32_t state_size_;    // bytes per state slot
+  uint32_t frame_size_;    // bytes per frame slot, 0: no frames
+
+  uint64_t state_offset_;  // from the start of the header
+  uint64_t frame_offset_;
+
+  SDL_atomic_t state_latest_;  // generation of the newest state
+  SDL_atomic_t frame_latest_;  // generation of the newest frame, 0: none
+} ShmHeader;
+
+/**
+ *  A mapping of the shared memory object, by its writer (the game)
+ *  or by a reader.
+ **/
+typedef struct {
+  char name_[SHM_NAME_MAX];
+  bool owner_;  // created it, unlinks it on close
+  size_t size_;
+
+  ShmHeader* header_;
+} ShmRing;
+
+typedef struct {
+  bool (*create)(ShmRing*, char const*, int, int, int);
+  bool (*attach)(ShmRing*, char const*);
+  void (*close)(ShmRing*);
+  void (*publish)(ShmRing*, World const*);
+  void* (*frame_begin)(ShmRing*, int*, int*, int*);
+  void (*frame_end)(ShmRing*, uint32_t);
+  ShmState const* (*state)(ShmRing const*, int*);
+  ShmFrame const* (*frame)(ShmRing const*, int*);
+  bool (*valid)(SDL_atomic_t const*, int);
+  ShmEntity const* (*entities)(ShmState const*);
+} ShmExport;
+
+#endif  // UXI_SHM_H
+
+// shm.h
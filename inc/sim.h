@@ -0,0 +1,217 @@
+/**
+ *  @file       sim.h
+ *  @brief      The sim file's header information.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The simulation header file.  The world (Scene, Wings, lasers,
+ *  meteors and its own dice stream) is plain C state stepped one fixed
+ *  tick at a time by Simulator::step; it knows nothing of SDL, windows or
+ *  sprites, only the Shape (size and mask) of each kind of object.  The
+ *  game renders it; libloaded_sim.a runs it on its own.
+ **/
+
+#ifndef UXI_SIM_H
+#define UXI_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "collide.h"
+#include "dice.h"
+#include "grid.h"
+#include "meteor.h"
+
+#define TICK_INTERVAL 40  // 模擬的固定步長 (ms)
+#define WINGS_STEP 10     // 戰機每個 tick 移動的距離
+
+#define SIM_MAX_WORKERS 64   // 與 JOBS_MAX_WORKERS 相同
+#define SIM_METEOR_KINDS 16  // 隕石外形種類的上限
+#define LASER_FRAMES 11      // 雷射的動畫格數, 最後 4 格為爆炸
+#define LASER_POOL_CAPACITY 4096
+
+/**
+ *  The size and the (optional) pixel mask of an object, all the
+ *  simulation needs of a sprite.  A NULL mask is a solid box.
+ **/
+typedef struct {
+  int w_;
+  int h_;
+
+  Bitmask const* mask_;
+} Shape;
+
+typedef struct Laser {
+  bool body_enable;
+  bool exploding;
+  int exploding_idx;
+  bool visible_;
+
+  int velocity_;
+
+  int idx;
+  int frame_;  // animation frame to draw, 0 .. LASER_FRAMES - 1
+
+  Rect box_;
+} Laser;
+
+/**
+ *  Fixed-capacity storage for Laser objects.
+ *
+ *  `slots_` holds every Laser contiguously.  `index_` is a sparse set
+ *  over the slots: its first `count_` entries are the live slots (in
+ *  iteration order), the rest form the free-index stack whose top is
+ *  `index_[count_]`.  Spawning pops the stack, destroying swaps the
+ *  dead entry with the last live one, so neither touches the heap.
+ **/
+typedef struct {
+  int capacity_;
+  int count_;
+
+  int* index_;
+  Laser* slots_;
+} LaserPool;
+
+typedef struct {
+  int obj_counts_;
+  int sprite_counts_;  // kinds of meteors
+
+  Rect box_;
+  Point cell_;  // meteors spawn one per cell of this size
+
+  LaserPool lasers_;
+  MeteorStore meteors_;
+  Grid grid_;
+} Scene;
+
+typedef struct {
+  bool alive;
+  int health;
+  int num_life;
+  uint32_t shot_laser_next_time;
+
+  Point position_;
+  Point last_position_;  // position at the start of the tick
+} Wings;
+
+/**
+ *  The player's input, sampled once per simulation tick.
+ **/
+typedef struct {
+  bool up_;
+  bool down_;
+  bool left_;
+  bool right_;
+  bool fire_;
+  bool quit_;
+} Input;
+
+/**
+ *  Everything a world is made from.  Two worlds made from the same
+ *  config and stepped with the same inputs stay identical.
+ **/
+typedef struct {
+  uint64_t seed_;
+
+  int width_;
+  int height_;
+  int meteors_;    // 0: one meteor per 256 x 192 cell
+  int lasers_;     // laser pool capacity, 0: LASER_POOL_CAPACITY
+  int fire_rate_;  // lasers per second, 0: one every 400 ms
+  bool stress_;    // the ship cannot die
+
+  int kinds_;  // meteor kinds, at most SIM_METEOR_KINDS
+  Shape meteor_shapes_[SIM_METEOR_KINDS];
+  Shape ship_;
+  Shape laser_;
+} WorldConfig;
+
+typedef enum {
+  SIM_UPDATE_LASERS,
+  SIM_UPDATE_METEORS,
+  SIM_COLLIDE_LASERS,
+  SIM_COLLIDE_WINGS,
+  SIM_PHASES
+} SimPhase;
+
+/**
+ *  Body of WorldHooks::parallel_for, the same as JobRange.
+ **/
+typedef void (*SimRange)(void* context, int begin, int end, int worker);
+
+/**
+ *  What a world may borrow from its host; any of them may be NULL.
+ *  Without `parallel_for` a world steps on the calling thread only.
+ *  `event` sees the gameplay events (laser spawns, hits, ...) and
+ *  `phase` the start and end of each phase of a tick.
+ **/
+typedef struct {
+  void (*parallel_for)(int, int, SimRange, void*);
+  int workers;
+
+  void (*event)(char const*, int32_t);
+  void (*phase)(SimPhase, bool, uint32_t);
+} WorldHooks;
+
+typedef struct {
+  uint32_t tick_;
+
+  WorldConfig config_;
+  WorldHooks hooks_;
+  DiceStream dice_;
+
+  Scene scene_;
+  Wings wings_;
+
+  int kills_;   // 上一個 tick 擊落的隕石數
+  int damage_;  // 上一個 tick 戰機受到的傷害
+
+  // 每個 tick 重複使用的暫存區
+  int32_t* tally_;  // 每段剔除的隕石數
+  int32_t* hit_;    // 每個 laser 先撞上的隕石
+  float* toi_;      // 撞上的時間 (0 .. 1)
+  GridMarks marks_[SIM_MAX_WORKERS];
+  int32_t* candidates_[SIM_MAX_WORKERS];
+} World;
+
+typedef struct {
+  void (*init)(World*, WorldConfig const*, WorldHooks const*);
+  void (*release)(World*);
+  void (*reset)(World*, uint64_t);
+  void (*step)(World*, Input const*);
+  void (*pilot)(World const*, Input*);
+  uint32_t (*hash)(World const*);
+} Simulator;
+
+#endif  // UXI_SIM_H
+
+// sim.h
@@ -0,0 +1,99 @@
+/**
+ *  @file       snapshot.h
+ *  @brief      Declares the world snapshot types.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The snapshot header file.  The simulation thread publishes the
+ *  world as immutable snapshots; the render thread draws the latest
+ *  one.  Three slots are rotated so neither side ever waits for the
+ *  other: one being written, one ready, one being drawn.
+ **/
+
+#ifndef UXI_SNAPSHOT_H
+#define UXI_SNAPSHOT_H
+
+#include <stdbool.h>
+
+#include <SDL2/SDL.h>
+
+#include "game.h"
+
+#define SNAPSHOT_SLOTS 3
+
+typedef struct {
+  SDL_Rect box_;  // where to draw at the end of the tick
+  int dx_;        // movement during the tick, for interpolation
+  int dy_;
+
+  Sprite const* sprite_;
+} Pose;
+
+typedef struct {
+  Uint32 tick_;
+  Uint64 stamp_;  // performance counter when published
+
+  bool alive_;
+  int health_;
+
+  SDL_Point wings_;       // ship position at the end of the tick
+  SDL_Point wings_last_;  // ship position at the start of the tick
+
+  int meteor_count_;  // visible meteors only
+  int laser_count_;   // visible lasers only
+
+  Pose* meteors_;
+  Pose* lasers_;
+} Snapshot;
+
+typedef struct {
+  SDL_mutex* lock_;
+
+  int back_;   // slot the simulation writes
+  int ready_;  // latest published slot
+  int front_;  // slot the renderer draws
+  bool fresh_;  // ready_ is newer than front_
+
+  Snapshot slots_[SNAPSHOT_SLOTS];
+} SnapshotQueue;
+
+typedef struct {
+  void (*init)(SnapshotQueue*, int, int);
+  void (*release)(SnapshotQueue*);
+  Snapshot* (*back)(SnapshotQueue*);
+  void (*publish)(SnapshotQueue*);
+  Snapshot const* (*acquire)(SnapshotQueue*);
+} SnapshotExchange;
+
+#endif  // UXI_SNAPSHOT_H
+
+// snapshot.h
@@ -0,0 +1,87 @@
+/**
+ *  @file       trace.h
+ *  @brief      The trace file's header information.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10-16-2026 created.
+ *  @date       10-16-2026 last modified.
+ *  @version    0.1.0
+ *  @setion     License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The event trace header file.  Records timestamped events (spans and
+ *  instants) into per-thread buffers and writes them as Chrome trace
+ *  JSON, which chrome://tracing and Perfetto open.
+ **/
+
+#ifndef UXI_TRACE_H
+#define UXI_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <SDL2/SDL.h>
+
+#define TRACE_THREADS 80  // 主執行緒, 模擬執行緒與所有 workers
+#define TRACE_EVENTS 4096  // 每個執行緒一開始的事件數, 不夠時加倍
+#define TRACE_EVENTS_MAX (1 << 22)  // 每個執行緒的事件數上限
+#define TRACE_NAME_MAX 32
+
+typedef struct {
+  char const* name_;  // must outlive the trace: a literal or a sprite name
+  Uint64 stamp_;
+  int32_t value_;  // instant events only
+  char phase_;     // 'B' begin, 'E' end, 'i' instant
+} TraceEvent;
+
+/**
+ *  The events of one thread.  Only the owning thread writes (and
+ *  grows) it, so no lock is taken; stop() reads it once no write is
+ *  under way.
+ **/
+typedef struct {
+  char name_[TRACE_NAME_MAX];
+  int count_;
+  int capacity_;
+  int dropped_;  // events lost to a full buffer
+  int open_;     // spans begun and recorded, not yet ended
+  int skipped_;  // spans begun and dropped, not yet ended
+  TraceEvent* events_;
+} TraceBuffer;
+
+typedef struct {
+  bool (*start)(char const*);
+  void (*thread)(char const*);
+  void (*begin)(char const*);
+  void (*end)(char const*);
+  void (*instant)(char const*, int32_t);
+  void (*stop)(void);
+} Trace;
+
+#endif  // UXI_TRACE_H
+
+// trace.h
@@ -0,0 +1,219 @@
+/**
+ *  @file       atlas.c
+ *  @brief      Defines the texture atlas packer.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The atlas file.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "atlas.h"
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static void open_(Atlas *, int, int);
+static bool pack_(Atlas *, Sprite *, SDL_Surface *);
+static bool bake_(Atlas *, SDL_Renderer *);
+static void close_(Atlas *);
+static void blit_(SDL_Surface *, int, int, int, int, SDL_Surface *, int, int);
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global AtlasPacker object.
+ *
+ *  @since  0.1.0
+ **/
+AtlasPacker atlas_packer = {open_, pack_, bake_, close_};  // atlas_packer
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Start an empty, fully transparent w x h page.
+ *
+ *  @param Atlas * the page.
+ *  @param int page width.
+ *  @param int page height.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void open_(Atlas *atlas, int w, int h) {
+  atlas->w_ = w;
+  atlas->h_ = h;
+
+  atlas->shelf_x_ = 0;
+  atlas->shelf_y_ = 0;
+  atlas->shelf_h_ = 0;
+
+  atlas->count_ = 0;
+  atlas->capacity_ = 0;
+  atlas->sprites_ = (Sprite **)NULL;
+
+  atlas->texture_ = (SDL_Texture *)NULL;
+  atlas->surface_ =
+      SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32);
+
+  if (atlas->surface_ == (SDL_Surface *)NULL) {
+    printf("SDL Error: %s\n", SDL_GetError());
+
+    exit(-1);
+  }  // fi
+
+  SDL_FillRect(atlas->surface_, (SDL_Rect *)NULL, 0);
+}  // open_()
+
+/**
+ *  Copy a w x h block of src at (sx, sy) to dst at (dx, dy).
+ *
+ *  @since  0.1.0
+ **/
+void blit_(SDL_Surface *src, int sx, int sy, int w, int h, SDL_Surface *dst,
+           int dx, int dy) {
+  SDL_Rect from = {sx, sy, w, h};
+  SDL_Rect to = {dx, dy, w, h};
+
+  SDL_BlitSurface(src, &from, dst, &to);
+}  // blit_()
+
+/**
+ *  Copy the image into the next free spot of the page and point the
+ *  sprite's rect_ at it.  The sprite's texture_ is set by bake().
+ *
+ *  @param Atlas * the page.
+ *  @param Sprite * the sprite the image belongs to.
+ *  @param SDL_Surface * the decoded image.
+ *  @return bool false when the page has no room left.
+ *  @since  0.1.0
+ **/
+bool pack_(Atlas *atlas, Sprite *sprite, SDL_Surface *surface) {
+  int w = surface->w;
+  int h = surface->h;
+  int x = 0;
+  int y = 0;
+
+  // 換到下一層 shelf
+  if (atlas->shelf_x_ + w + 2 > atlas->w_) {
+    atlas->shelf_y_ += atlas->shelf_h_;
+    atlas->shelf_x_ = 0;
+    atlas->shelf_h_ = 0;
+  }  // fi
+
+  if (w + 2 > atlas->w_ || atlas->shelf_y_ + h + 2 > atlas->h_) {
+    return false;
+  }  // fi
+
+  x = atlas->shelf_x_ + 1;
+  y = atlas->shelf_y_ + 1;
+
+  // 直接複製像素 (含 alpha), 不做混色
+  SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+
+  blit_(surface, 0, 0, w, h, atlas->surface_, x, y);
+
+  // 將邊緣像素向外複製一圈
+  blit_(surface, 0, 0, w, 1, atlas->surface_, x, y - 1);
+  blit_(surface, 0, h - 1, w, 1, atlas->surface_, x, y + h);
+  blit_(surface, 0, 0, 1, h, atlas->surface_, x - 1, y);
+  blit_(surface, w - 1, 0, 1, h, atlas->surface_, x + w, y);
+
+  atlas->shelf_x_ += w + 2;
+  if (h + 2 > atlas->shelf_h_) atlas->shelf_h_ = h + 2;
+
+  sprite->rect_.x = x;
+  sprite->rect_.y = y;
+  sprite->rect_.w = w;
+  sprite->rect_.h = h;
+  sprite->texture_ = (SDL_Texture *)NULL;
+
+  if (atlas->count_ == atlas->capacity_) {
+    atlas->capacity_ = (atlas->capacity_ == 0) ? 16 : atlas->capacity_ * 2;
+    atlas->sprites_ = (Sprite **)realloc(
+        atlas->sprites_, sizeof(Sprite *) * atlas->capacity_);
+  }  // fi
+
+  atlas->sprites_[atlas->count_++] = sprite;
+
+  return true;
+}  // pack_()
+
+/**
+ *  Upload the page as one texture, release its pixels and hand the
+ *  texture to every sprite packed on it.
+ *
+ *  @return bool false when the texture cannot be created.
+ *  @since  0.1.0
+ **/
+bool bake_(Atlas *atlas, SDL_Renderer *renderer) {
+  atlas->texture_ = SDL_CreateTextureFromSurface(renderer, atlas->surface_);
+
+  if (atlas->texture_ == (SDL_Texture *)NULL) {
+    return false;
+  }  // fi
+
+  SDL_SetTextureBlendMode(atlas->texture_, SDL_BLENDMODE_BLEND);
+
+  SDL_FreeSurface(atlas->surface_);
+  atlas->surface_ = (SDL_Surface *)NULL;
+
+  for (int i = 0; i < atlas->count_; ++i) {
+    atlas->sprites_[i]->texture_ = atlas->texture_;
+  }  // od
+
+  return true;
+}  // bake_()
+
+/**
+ *  Release the page's texture (or its pixels, if never baked).
+ *
+ *  @since  0.1.0
+ **/
+void close_(Atlas *atlas) {
+  if (atlas->surface_ != (SDL_Surface *)NULL) {
+    SDL_FreeSurface(atlas->surface_);
+  }  // fi
+
+  if (atlas->texture_ != (SDL_Texture *)NULL) {
+    SDL_DestroyTexture(atlas->texture_);
+  }  // fi
+
+  free(atlas->sprites_);
+
+  atlas->surface_ = (SDL_Surface *)NULL;
+  atlas->texture_ = (SDL_Texture *)NULL;
+  atlas->sprites_ = (Sprite **)NULL;
+  atlas->count_ = 0;
+  atlas->capacity_ = 0;
+}  // close_()
+
+// atlas.c
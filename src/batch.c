@@ -0,0 +1,217 @@
+/**
+ *  @file       batch.c
+ *  @brief      Defines the sprite batcher.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The batch file.
+ **/
+
+#include <stdlib.h>
+
+#include "batch.h"
+
+// SDL_RenderGeometry() 自 SDL 2.0.18 起才有
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+#define UXI_BATCH_GEOMETRY 1
+#endif
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static void init_(SpriteBatch *, SDL_Renderer *, int);
+static void release_(SpriteBatch *);
+static void draw_(SpriteBatch *, SDL_Texture *, SDL_BlendMode,
+                  SDL_Rect const *, SDL_Rect const *);
+static void flush_(SpriteBatch *);
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global SpriteBatcher object.
+ *
+ *  @since  0.1.0
+ **/
+SpriteBatcher sprite_batcher = {
+    init_, release_, draw_, flush_,
+};  // sprite_batcher
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Allocate a batch of `capacity` quads.  The index buffer never
+ *  changes, so it is filled once here.
+ *
+ *  @param SpriteBatch * the batch.
+ *  @param SDL_Renderer * the renderer the batch submits to.
+ *  @param int maximum number of quads per draw call.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void init_(SpriteBatch *batch, SDL_Renderer *renderer, int capacity) {
+  batch->count_ = 0;
+  batch->capacity_ = capacity;
+  batch->calls_ = 0;
+
+  batch->tex_w_ = 1;
+  batch->tex_h_ = 1;
+
+  batch->renderer_ = renderer;
+  batch->texture_ = (SDL_Texture *)NULL;
+  batch->blend_ = SDL_BLENDMODE_BLEND;
+
+  batch->vertices_ = (SDL_Vertex *)malloc(sizeof(SDL_Vertex) * 4 * capacity);
+  batch->indices_ = (int *)malloc(sizeof(int) * 6 * capacity);
+
+  // 每個 quad 兩個三角形: 0-1-2, 2-3-0
+  for (int i = 0; i < capacity; ++i) {
+    batch->indices_[i * 6 + 0] = i * 4 + 0;
+    batch->indices_[i * 6 + 1] = i * 4 + 1;
+    batch->indices_[i * 6 + 2] = i * 4 + 2;
+    batch->indices_[i * 6 + 3] = i * 4 + 2;
+    batch->indices_[i * 6 + 4] = i * 4 + 3;
+    batch->indices_[i * 6 + 5] = i * 4 + 0;
+  }  // od
+
+  for (int i = 0; i < 4 * capacity; ++i) {
+    batch->vertices_[i].color.r = 255;
+    batch->vertices_[i].color.g = 255;
+    batch->vertices_[i].color.b = 255;
+    batch->vertices_[i].color.a = 255;
+  }  // od
+}  // init_()
+
+/**
+ *  Release the buffers of a batch.
+ *
+ *  @since  0.1.0
+ **/
+void release_(SpriteBatch *batch) {
+  free(batch->vertices_);
+  free(batch->indices_);
+
+  batch->vertices_ = (SDL_Vertex *)NULL;
+  batch->indices_ = (int *)NULL;
+  batch->count_ = 0;
+  batch->capacity_ = 0;
+}  // release_()
+
+/**
+ *  Submit the queued quads as one draw call.
+ *
+ *  @since  0.1.0
+ **/
+void flush_(SpriteBatch *batch) {
+  if (batch->count_ == 0) {
+    return;
+  }  // fi
+
+#ifdef UXI_BATCH_GEOMETRY
+  SDL_SetTextureBlendMode(batch->texture_, batch->blend_);
+  SDL_RenderGeometry(batch->renderer_, batch->texture_, batch->vertices_,
+                     batch->count_ * 4, batch->indices_, batch->count_ * 6);
+#endif
+
+  batch->count_ = 0;
+  ++batch->calls_;
+}  // flush_()
+
+/**
+ *  Queue the src part of texture to be drawn at dst.
+ *
+ *  @param SpriteBatch * the batch.
+ *  @param SDL_Texture * the texture (an atlas page).
+ *  @param SDL_BlendMode how the quad is blended.
+ *  @param SDL_Rect const * source rect inside the texture.
+ *  @param SDL_Rect const * destination rect on the screen.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void draw_(SpriteBatch *batch, SDL_Texture *texture, SDL_BlendMode blend,
+           SDL_Rect const *src, SDL_Rect const *dst) {
+#ifdef UXI_BATCH_GEOMETRY
+  SDL_Vertex *v = (SDL_Vertex *)NULL;
+
+  float u0;
+  float v0;
+  float u1;
+  float v1;
+
+  if (texture != batch->texture_ || blend != batch->blend_ ||
+      batch->count_ == batch->capacity_) {
+    flush_(batch);
+
+    if (texture != batch->texture_) {
+      SDL_QueryTexture(texture, (Uint32 *)NULL, (int *)NULL, &batch->tex_w_,
+                       &batch->tex_h_);
+    }  // fi
+
+    batch->texture_ = texture;
+    batch->blend_ = blend;
+  }  // fi
+
+  u0 = (float)src->x / batch->tex_w_;
+  v0 = (float)src->y / batch->tex_h_;
+  u1 = (float)(src->x + src->w) / batch->tex_w_;
+  v1 = (float)(src->y + src->h) / batch->tex_h_;
+
+  v = batch->vertices_ + batch->count_ * 4;
+
+  v[0].position.x = (float)dst->x;
+  v[0].position.y = (float)dst->y;
+  v[0].tex_coord.x = u0;
+  v[0].tex_coord.y = v0;
+
+  v[1].position.x = (float)(dst->x + dst->w);
+  v[1].position.y = (float)dst->y;
+  v[1].tex_coord.x = u1;
+  v[1].tex_coord.y = v0;
+
+  v[2].position.x = (float)(dst->x + dst->w);
+  v[2].position.y = (float)(dst->y + dst->h);
+  v[2].tex_coord.x = u1;
+  v[2].tex_coord.y = v1;
+
+  v[3].position.x = (float)dst->x;
+  v[3].position.y = (float)(dst->y + dst->h);
+  v[3].tex_coord.x = u0;
+  v[3].tex_coord.y = v1;
+
+  ++batch->count_;
+#else
+  // 舊版 SDL 沒有 geometry API, 逐一繪製
+  SDL_SetTextureBlendMode(texture, blend);
+  SDL_RenderCopy(batch->renderer_, texture, src, dst);
+
+  ++batch->calls_;
+#endif
+}  // draw_()
+
+// batch.c
@@ -0,0 +1,672 @@
+/**
+ *  @file       collide.c
+ *  @brief      Defines the collision narrowphase.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The collide file.
+ **/
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define UXI_COLLIDE_X86 1
+#endif
+
+#include "collide.h"
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static bool aabb_(Rect const *, Rect const *);
+static int aabb_batch_(Rect const *, int32_t const *, int32_t const *,
+                       int32_t const *, int32_t const *, int, int32_t *);
+static int aabb_batch_scalar_(Rect const *, int32_t const *,
+                              int32_t const *, int32_t const *,
+                              int32_t const *, int, int, int32_t *, int);
+static bool test_(Collider const *, Collider const *);
+
+static void mask_alloc_(Bitmask *, int, int);
+static void mask_release_(Bitmask *);
+static uint64_t mask_fetch_(Bitmask const *, int, int);
+static bool masks_(Rect const *, Bitmask const *, Rect const *,
+                   Bitmask const *);
+static bool sweep_aabb_(Rect const *, Rect const *, Point const *,
+                        float *, float *);
+static bool sweep_(Rect const *, Bitmask const *, Point const *,
+                   Rect const *, Bitmask const *, Point const *,
+                   float *);
+
+#ifdef UXI_COLLIDE_X86
+static void detect_(void) __attribute__((constructor));
+static int aabb_batch_sse2_(Rect const *, int32_t const *,
+                            int32_t const *, int32_t const *,
+                            int32_t const *, int, int32_t *);
+static int aabb_batch_avx2_(Rect const *, int32_t const *,
+                            int32_t const *, int32_t const *,
+                            int32_t const *, int, int32_t *);
+#endif
+
+static void vector_assign_(Point *, Point *);
+static void vector_neg_(Point *);
+static int vector_dot_(Point const *, Point const *);
+static void vector_minus_(Point *, Point *, Point *);
+
+static void gjk_support_(Collider const *, Point const *, Point *);
+static bool gjk_simplex_(Point *, Point *);
+static bool gjk_(Collider const *, Collider const *);
+
+// 內部資料欄位 (private data) 宣告
+#ifdef UXI_COLLIDE_X86
+static int avx2_ = 0;  // 載入時由 detect_() 設定一次, 之後只讀
+#endif
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global Collide object.
+ *
+ *  @since  0.1.0
+ **/
+Collide collide = {
+    aabb_,        aabb_batch_,   gjk_,   test_,
+    mask_alloc_,  mask_release_, masks_, sweep_,
+};  // collide
+
+// 函數 (方法) 的實作 (implementations)
+
+#ifdef UXI_COLLIDE_X86
+
+/**
+ *  Detect AVX2 once, when the program loads and before any worker
+ *  runs, so the kernels only read the result.
+ *
+ *  @since  0.1.0
+ **/
+void detect_(void) {
+  __builtin_cpu_init();
+  avx2_ = __builtin_cpu_supports("avx2") ? 1 : 0;
+}  // detect_()
+
+#endif
+
+/**
+ *  Branch-free overlap test of two axis-aligned rectangles.  Edges
+ *  or corners that merely touch (zero-area contact) count as a hit.
+ *  gjk_() reports such pairs either way; it agrees with aabb_() on
+ *  every other pair (bench/fuzz.c checks both).
+ *
+ *  @since  0.1.0
+ **/
+bool aabb_(Rect const *a, Rect const *b) {
+  return (a->x <= b->x + b->w) & (b->x <= a->x + a->w) &
+         (a->y <= b->y + b->h) & (b->y <= a->y + a->h);
+}  // aabb_()
+
+/**
+ *  Test one rectangle against n rectangles packed as separate x, y,
+ *  w, h arrays.  The indices of the hit rectangles are written to
+ *  `hits` in ascending order.
+ *
+ *  @return int number of hits.
+ *  @since  0.1.0
+ **/
+int aabb_batch_(Rect const *box, int32_t const *x, int32_t const *y,
+                int32_t const *w, int32_t const *h, int n, int32_t *hits) {
+#ifdef UXI_COLLIDE_X86
+  if (avx2_) {
+    return aabb_batch_avx2_(box, x, y, w, h, n, hits);
+  }  // fi
+
+  return aabb_batch_sse2_(box, x, y, w, h, n, hits);
+#else
+  return aabb_batch_scalar_(box, x, y, w, h, 0, n, hits, 0);
+#endif
+}  // aabb_batch_()
+
+/**
+ *  Scalar batch test over [from, n), also used for the tail the
+ *  vector kernels leave.
+ *
+ *  @since  0.1.0
+ **/
+int aabb_batch_scalar_(Rect const *box, int32_t const *x,
+                       int32_t const *y, int32_t const *w, int32_t const *h,
+                       int from, int n, int32_t *hits, int count) {
+  for (int i = from; i < n; ++i) {
+    Rect other = {x[i], y[i], w[i], h[i]};
+
+    hits[count] = i;
+    count += aabb_(box, &other);
+  }  // od
+
+  return count;
+}  // aabb_batch_scalar_()
+
+#ifdef UXI_COLLIDE_X86
+
+/**
+ *  SSE2 batch test, 4 rectangles per instruction.
+ *
+ *  @since  0.1.0
+ **/
+__attribute__((target("sse2"))) int aabb_batch_sse2_(
+    Rect const *box, int32_t const *x, int32_t const *y,
+    int32_t const *w, int32_t const *h, int n, int32_t *hits) {
+  __m128i const x0 = _mm_set1_epi32(box->x);
+  __m128i const y0 = _mm_set1_epi32(box->y);
+  __m128i const x1 = _mm_set1_epi32(box->x + box->w);
+  __m128i const y1 = _mm_set1_epi32(box->y + box->h);
+
+  int count = 0;
+  int i = 0;
+
+  for (; i + 4 <= n; i += 4) {
+    __m128i bx0 = _mm_loadu_si128((__m128i const *)(x + i));
+    __m128i by0 = _mm_loadu_si128((__m128i const *)(y + i));
+    __m128i bx1 =
+        _mm_add_epi32(bx0, _mm_loadu_si128((__m128i const *)(w + i)));
+    __m128i by1 =
+        _mm_add_epi32(by0, _mm_loadu_si128((__m128i const *)(h + i)));
+
+    // 任一軸分離即沒有碰撞
+    __m128i miss = _mm_or_si128(
+        _mm_or_si128(_mm_cmpgt_epi32(x0, bx1), _mm_cmpgt_epi32(bx0, x1)),
+        _mm_or_si128(_mm_cmpgt_epi32(y0, by1), _mm_cmpgt_epi32(by0, y1)));
+
+    unsigned mask = ~(unsigned)_mm_movemask_ps(_mm_castsi128_ps(miss)) & 0xf;
+
+    while (mask != 0) {
+      hits[count++] = i + __builtin_ctz(mask);
+      mask &= mask - 1;
+    }  // od
+  }    // od
+
+  return aabb_batch_scalar_(box, x, y, w, h, i, n, hits, count);
+}  // aabb_batch_sse2_()
+
+/**
+ *  AVX2 batch test, 8 rectangles per instruction.
+ *
+ *  @since  0.1.0
+ **/
+__attribute__((target("avx2"))) int aabb_batch_avx2_(
+    Rect const *box, int32_t const *x, int32_t const *y,
+    int32_t const *w, int32_t const *h, int n, int32_t *hits) {
+  __m256i const x0 = _mm256_set1_epi32(box->x);
+  __m256i const y0 = _mm256_set1_epi32(box->y);
+  __m256i const x1 = _mm256_set1_epi32(box->x + box->w);
+  __m256i const y1 = _mm256_set1_epi32(box->y + box->h);
+
+  int count = 0;
+  int i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    __m256i bx0 = _mm256_loadu_si256((__m256i const *)(x + i));
+    __m256i by0 = _mm256_loadu_si256((__m256i const *)(y + i));
+    __m256i bx1 =
+        _mm256_add_epi32(bx0, _mm256_loadu_si256((__m256i const *)(w + i)));
+    __m256i by1 =
+        _mm256_add_epi32(by0, _mm256_loadu_si256((__m256i const *)(h + i)));
+
+    __m256i miss = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpgt_epi32(x0, bx1),
+                        _mm256_cmpgt_epi32(bx0, x1)),
+        _mm256_or_si256(_mm256_cmpgt_epi32(y0, by1),
+                        _mm256_cmpgt_epi32(by0, y1)));
+
+    unsigned mask =
+        ~(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(miss)) & 0xff;
+
+    while (mask != 0) {
+      hits[count++] = i + __builtin_ctz(mask);
+      mask &= mask - 1;
+    }  // od
+  }    // od
+
+  return aabb_batch_scalar_(box, x, y, w, h, i, n, hits, count);
+}  // aabb_batch_avx2_()
+
+#endif  // UXI_COLLIDE_X86
+
+/**
+ *  Narrowphase dispatcher: rectangle pairs take the AABB test, any
+ *  pair involving a polygon goes through GJK.
+ *
+ *  @since  0.1.0
+ **/
+bool test_(Collider const *a, Collider const *b) {
+  if (a->kind_ == COLLIDER_AABB && b->kind_ == COLLIDER_AABB) {
+    return aabb_(&a->box_, &b->box_);
+  }  // fi
+
+  // 先以外框快速排除
+  if (!aabb_(&a->box_, &b->box_)) {
+    return false;
+  }  // fi
+
+  return gjk_(a, b);
+}  // test_()
+
+/**
+ *  Allocate an all-clear w x h bitmask.
+ *
+ *  @since  0.1.0
+ **/
+void mask_alloc_(Bitmask *mask, int w, int h) {
+  mask->w_ = w;
+  mask->h_ = h;
+  mask->words_ = (w + 63) / 64;
+  mask->bits_ = (uint64_t *)calloc(mask->words_ * h, sizeof(uint64_t));
+}  // mask_alloc_()
+
+/**
+ *  Release a bitmask.
+ *
+ *  @since  0.1.0
+ **/
+void mask_release_(Bitmask *mask) {
+  free(mask->bits_);
+
+  mask->bits_ = (uint64_t *)NULL;
+  mask->words_ = 0;
+}  // mask_release_()
+
+/**
+ *  Fetch the 64 mask bits of row y starting at pixel x (x may be
+ *  unaligned).  Bits past the row end read as clear; a NULL mask
+ *  is solid.
+ *
+ *  @since  0.1.0
+ **/
+uint64_t mask_fetch_(Bitmask const *mask, int x, int y) {
+  uint64_t const *row = (uint64_t const *)NULL;
+  uint64_t bits = 0;
+
+  int word = x >> 6;
+  int shift = x & 63;
+
+  if (mask == (Bitmask const *)NULL) {
+    return ~(uint64_t)0;
+  }  // fi
+
+  row = mask->bits_ + y * mask->words_;
+  bits = row[word] >> shift;
+
+  if (shift != 0 && word + 1 < mask->words_) {
+    bits |= row[word + 1] << (64 - shift);
+  }  // fi
+
+  return bits;
+}  // mask_fetch_()
+
+/**
+ *  Pixel-accurate collision of two masked sprites placed at the
+ *  rectangles a and b (a NULL mask is solid).  Pixels of a rectangle
+ *  beyond its mask read as clear, so a rectangle larger than its mask
+ *  never reads past the bits.  Rejects on the rectangles first, then
+ *  ANDs the overlapping rows 64 pixels at a time.
+ *
+ *  @since  0.1.0
+ **/
+bool masks_(Rect const *a, Bitmask const *mask_a, Rect const *b,
+            Bitmask const *mask_b) {
+  int x0 = (a->x > b->x) ? a->x : b->x;
+  int y0 = (a->y > b->y) ? a->y : b->y;
+  int x1 = (a->x + a->w < b->x + b->w) ? a->x + a->w : b->x + b->w;
+  int y1 = (a->y + a->h < b->y + b->h) ? a->y + a->h : b->y + b->h;
+
+  // 只看遮罩涵蓋的部分, 外框與遮罩不一樣大時也不會讀出界
+  if (mask_a != (Bitmask const *)NULL) {
+    x1 = (a->x + mask_a->w_ < x1) ? a->x + mask_a->w_ : x1;
+    y1 = (a->y + mask_a->h_ < y1) ? a->y + mask_a->h_ : y1;
+  }  // fi
+
+  if (mask_b != (Bitmask const *)NULL) {
+    x1 = (b->x + mask_b->w_ < x1) ? b->x + mask_b->w_ : x1;
+    y1 = (b->y + mask_b->h_ < y1) ? b->y + mask_b->h_ : y1;
+  }  // fi
+
+  if (x0 >= x1 || y0 >= y1) {
+    return false;
+  }  // fi
+
+  for (int y = y0; y < y1; ++y) {
+    for (int x = x0; x < x1; x += 64) {
+      int n = x1 - x;
+      uint64_t bits = (n >= 64) ? ~(uint64_t)0 : (((uint64_t)1 << n) - 1);
+
+      bits &= mask_fetch_(mask_a, x - a->x, y - a->y);
+      bits &= mask_fetch_(mask_b, x - b->x, y - b->y);
+
+      if (bits != 0) {
+        return true;
+      }  // fi
+    }    // od
+  }      // od
+
+  return false;
+}  // masks_()
+
+/**
+ *  Swept AABB test: rectangle a moves by v relative to the fixed b.
+ *  Computes the [t0, t1] sub-interval of [0, 1] during which the two
+ *  rectangles overlap (touching counts, as in aabb_()).
+ *
+ *  @return bool false when they never overlap within the tick.
+ *  @since  0.1.0
+ **/
+bool sweep_aabb_(Rect const *a, Rect const *b, Point const *v,
+                 float *t0, float *t1) {
+  int const lo[2] = {b->x - (a->x + a->w), b->y - (a->y + a->h)};
+  int const hi[2] = {b->x + b->w - a->x, b->y + b->h - a->y};
+  int const d[2] = {v->x, v->y};
+
+  float enter = 0.0f;
+  float leave = 1.0f;
+
+  // 逐軸 (slab) 求出重疊的時間區間, 再取交集
+  for (int k = 0; k < 2; ++k) {
+    float e;
+    float l;
+
+    if (d[k] == 0) {
+      if (lo[k] > 0 || hi[k] < 0) {
+        return false;
+      }  // fi
+
+      continue;
+    }  // fi
+
+    e = (float)((d[k] > 0) ? lo[k] : hi[k]) / d[k];
+    l = (float)((d[k] > 0) ? hi[k] : lo[k]) / d[k];
+
+    if (e > enter) enter = e;
+    if (l < leave) leave = l;
+  }  // od
+
+  if (enter > leave) {
+    return false;
+  }  // fi
+
+  *t0 = enter;
+  *t1 = leave;
+
+  return true;
+}  // sweep_aabb_()
+
+/**
+ *  Continuous collision of two masked sprites over one tick.  a and b
+ *  are the rectangles at the start of the tick, da and db their
+ *  displacements during it.  The swept AABB test narrows the tick to
+ *  the interval in which the boxes overlap; that interval is then
+ *  walked one pixel of relative motion at a time with masks_().  The
+ *  end of the tick is always among the tested positions, so anything
+ *  masks_() reports at the final positions is found as well.
+ *
+ *  @param float * receives the earliest time of impact in [0, 1].
+ *  @return bool true when the two collide within the tick.
+ *  @since  0.1.0
+ **/
+bool sweep_(Rect const *a, Bitmask const *mask_a, Point const *da,
+            Rect const *b, Bitmask const *mask_b, Point const *db,
+            float *toi) {
+  Point v = {da->x - db->x, da->y - db->y};
+
+  // 兩者的位置各自取整, 相對位置最多差 2 個像素, 所以放寬 b 再求區間
+  Rect wide = {b->x - 2, b->y - 2, b->w + 4, b->h + 4};
+
+  float t0 = 0.0f;
+  float t1 = 0.0f;
+
+  int n = 0;
+  int k0 = 0;
+  int k1 = 0;
+
+  if (!sweep_aabb_(a, &wide, &v, &t0, &t1)) {
+    return false;
+  }  // fi
+
+  n = (v.x < 0) ? -v.x : v.x;
+  if (((v.y < 0) ? -v.y : v.y) > n) n = (v.y < 0) ? -v.y : v.y;
+
+  if (n == 0) {
+    *toi = 0.0f;
+
+    return masks_(a, mask_a, b, mask_b);
+  }  // fi
+
+  k0 = (int)(t0 * n);
+  k1 = (int)(t1 * n) + 1;
+  if (k1 > n) k1 = n;
+
+  for (int k = k0; k <= k1; ++k) {
+    Rect pa = {a->x + da->x * k / n, a->y + da->y * k / n, a->w, a->h};
+    Rect pb = {b->x + db->x * k / n, b->y + db->y * k / n, b->w, b->h};
+
+    if (masks_(&pa, mask_a, &pb, mask_b)) {
+      *toi = (float)k / n;
+
+      return true;
+    }  // fi
+  }    // od
+
+  return false;
+}  // sweep_()
+
+/**
+ *  Assign one vector's content to another.
+ *
+ *  @since  0.1.0
+ **/
+void vector_assign_(Point *p, Point *q) {
+  q->x = p->x;
+  q->y = p->y;
+}  // vector_assign_()
+
+/**
+ *  Negation operation on vector, i.e. v = -v;
+ *
+ *  @since  0.1.0
+ **/
+void vector_neg_(Point *p) {
+  p->x = 0 - p->x;
+  p->y = 0 - p->y;
+}  // vector_neg_()
+
+/**
+ *  Caculate and return vectors' dot product.
+ *
+ *  @since  0.1.0
+ **/
+int vector_dot_(Point const *p, Point const *q) {
+  return ((p->x * q->x) + (p->y * q->y));
+}  // vector_dot_()
+
+/**
+ *  Do *Minkowski difference* on passed-in vectors.
+ *
+ *  @since  0.1.0
+ **/
+void vector_minus_(Point *p, Point *q, Point *r) {
+  r->x = p->x - q->x;
+  r->y = p->y - q->y;
+}  // vector_minus_()
+
+/**
+ *  Support function used in gjk-algorithm: the point of the collider
+ *  furthest along the direction vec.
+ *
+ *  @since  0.1.0
+ **/
+void gjk_support_(Collider const *collider, Point const *vec,
+                  Point *point) {
+  Rect const *rect = &collider->box_;
+
+  if (collider->kind_ == COLLIDER_POLYGON) {
+    int best = 0;
+
+    for (int i = 1; i < collider->count_; ++i) {
+      if (vector_dot_(&collider->points_[i], vec) >
+          vector_dot_(&collider->points_[best], vec)) {
+        best = i;
+      }  // fi
+    }    // od
+
+    point->x = collider->points_[best].x;
+    point->y = collider->points_[best].y;
+
+    return;
+  }  // fi
+
+  point->x = rect->x;
+  point->y = rect->y;
+
+  if (vec->x >= 0) {
+    point->x += rect->w;
+  }  // fi
+
+  if (vec->y >= 0) {
+    point->y += rect->h;
+  }  // fi
+}  // gjk_support_()
+
+/**
+ *  Try to find a triangle which contains the origin.
+ *
+ *  @since  0.1.0
+ **/
+bool gjk_simplex_(Point *tri, Point *d) {
+  bool contain_origin = false;
+
+  Point ao;
+  Point ab;
+  Point ac;
+
+  vector_assign_(&tri[2], &ao);
+  vector_neg_(&ao);
+
+  vector_minus_(&tri[1], &tri[2], &ab);
+
+  d->x = 0 - ab.y;
+  d->y = ab.x;
+
+  if (vector_dot_(d, &tri[0]) > 0) {
+    vector_neg_(d);
+  }  // fi
+
+  if (vector_dot_(d, &ao) > 0) {
+    vector_assign_(&tri[2], &tri[1]);
+
+    return contain_origin;
+  }  // fi
+
+  vector_minus_(&tri[0], &tri[2], &ac);
+
+  d->x = 0 - ac.y;
+  d->y = ac.x;
+
+  if (vector_dot_(d, &tri[1]) > 0) {
+    vector_neg_(d);
+  }  // fi
+
+  if (vector_dot_(d, &ao) > 0) {
+    vector_assign_(&tri[2], &tri[0]);
+
+    return contain_origin;
+  }  // fi
+
+  contain_origin = true;
+
+  return contain_origin;
+}  // gjk_simplex_()
+
+/**
+ *  The GJK collision-detection algorithm.  A pair in zero-area
+ *  contact puts the origin on an edge of the simplex, and is a hit or
+ *  not depending on the order the support points come in.
+ *
+ *  @since  0.1.0
+ **/
+bool gjk_(Collider const *shape_a, Collider const *shape_b) {
+  bool collided = false;
+
+  Point p;
+  Point q;
+  Point d = {1, 0};
+  Point a[3];
+
+  gjk_support_(shape_a, &d, &p);
+
+  d.x = -1;
+  gjk_support_(shape_b, &d, &q);
+
+  vector_minus_(&p, &q, &a[0]);
+
+  vector_assign_(&a[0], &d);
+  gjk_support_(shape_b, &d, &q);
+
+  vector_neg_(&d);
+  gjk_support_(shape_a, &d, &p);
+
+  vector_minus_(&p, &q, &a[1]);
+
+  if (vector_dot_(&d, &a[1]) <= 0) {
+    return collided;
+  }  // fi
+
+  vector_assign_(&a[1], &d);
+  vector_neg_(&d);
+
+  while (true) {
+    gjk_support_(shape_a, &d, &p);
+    vector_neg_(&d);
+    gjk_support_(shape_b, &d, &q);
+    vector_neg_(&d);
+
+    vector_minus_(&p, &q, &a[2]);
+
+    if (vector_dot_(&d, &a[2]) <= 0) {
+      return collided;
+    }  // fi
+
+    if (gjk_simplex_(a, &d)) {
+      collided = true;
+
+      break;
+    };
+  }  // od
+
+  return collided;
+}  // gjk_()
+
+// collide.c
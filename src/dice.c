@@ -36,39 +36,217 @@
  *  The dice file.
  **/
 
-#include <stdlib.h>
-
 #include "dice.h"
 
 // 內部函數 (private functions) 的前置宣告 (forward declarations)
 static uint32_t roll_(uint32_t);
+static void fill_(uint32_t, uint32_t *, int);
+static void seed_(uint64_t);
+static void stream_(DiceStream *, int);
+static uint32_t roll_with_(DiceStream *, uint32_t);
+static void fill_with_(DiceStream *, uint32_t, uint32_t *, int);
+static void seed_with_(DiceStream *, uint64_t);
+
+static uint64_t next_(DiceStream *);
+static void jump_(DiceStream *);
+static uint64_t splitmix_(uint64_t *);
 
 // 內部資料欄位 (private variables) 的宣告 (declarations)
+// 未呼叫 seed() 前, 狀態等同 seed(0)
+static DiceStream seeded_ = {{
+    0xe220a8397b1dcdafULL, 0x6e789e6aa1b965f4ULL,
+    0x06c45d188009454fULL, 0xf88bb8a8724c81ecULL,
+}};  // seed() 的結果, stream() 由此衍生
+
+static DiceStream default_ = {{
+    0xe220a8397b1dcdafULL, 0x6e789e6aa1b965f4ULL,
+    0x06c45d188009454fULL, 0xf88bb8a8724c81ecULL,
+}};  // roll() 與 fill() 使用的 stream
 
 // 公開 (public) 物件的宣告
 
 /**
- *  The global Dice object.
+ *  The global Dice object.  roll() and fill() use the default stream,
+ *  which starts as stream 0 of the seed.
  *
  *  @since  0.1.0
  **/
-Dice dice = {roll_};  // dice
+Dice dice = {
+    roll_, fill_, seed_, stream_, roll_with_, fill_with_, seed_with_,
+};  // dice
 
 // 函數 (方法) 的實作 (implementations)
 
 /**
- *  The wrapper function for the random().
+ *  Roll the default stream.
  *
  *  @param  max the upper bound (ceiling) of the required range.
- *  @return a random number between min and max.
+ *  @return a random number in [0, max).
  *  @since  0.1.0
  **/
 uint32_t roll_(uint32_t max) {
-  uint32_t points;
+  return roll_with_(&default_, max);
+}  // roll_()
+
+/**
+ *  Fill `out` with `count` rolls of the default stream.
+ *
+ *  @since  0.1.0
+ **/
+void fill_(uint32_t max, uint32_t *out, int count) {
+  fill_with_(&default_, max, out, count);
+}  // fill_()
+
+/**
+ *  Seed the dice.  The default stream and every stream made by
+ *  stream() afterwards are derived from `seed`.
+ *
+ *  @param uint64_t the seed.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void seed_(uint64_t seed) {
+  seed_with_(&seeded_, seed);
 
-  points = (uint32_t)((rand() / ((double)RAND_MAX + 1)) * max);
+  default_ = seeded_;
+}  // seed_()
 
-  return points;
-}  // roll_()
+/**
+ *  Make the k-th stream of the current seed: the seeded state jumped
+ *  ahead k * 2^128 draws, so streams never overlap in practice.
+ *
+ *  @param DiceStream * the stream to initialize.
+ *  @param int k, 0 is the default stream's start.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void stream_(DiceStream *stream, int k) {
+  *stream = seeded_;
+
+  for (int i = 0; i < k; ++i) {
+    jump_(stream);
+  }  // od
+}  // stream_()
+
+/**
+ *  Seed a stream on its own: it rolls what the default stream rolls
+ *  after seed(`seed`), without touching the shared seed, so threads
+ *  may seed their streams at the same time.
+ *
+ *  @param DiceStream * the stream.
+ *  @param uint64_t the seed.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void seed_with_(DiceStream *stream, uint64_t seed) {
+  // splitmix64 展開 seed, 避免全為 0 的狀態
+  for (int i = 0; i < 4; ++i) {
+    stream->s_[i] = splitmix_(&seed);
+  }  // od
+}  // seed_with_()
+
+/**
+ *  Roll a stream: an unbiased number in [0, max) by Lemire's
+ *  multiply-shift, which needs a division only on the rare rejection
+ *  path.
+ *
+ *  @param DiceStream * the stream.
+ *  @param uint32_t the upper bound (ceiling) of the required range.
+ *  @return uint32_t a random number in [0, max).
+ *  @since  0.1.0
+ **/
+uint32_t roll_with_(DiceStream *stream, uint32_t max) {
+  uint64_t m = (next_(stream) >> 32) * (uint64_t)max;
+  uint32_t low = (uint32_t)m;
+
+  if (low < max) {
+    uint32_t threshold = (0u - max) % max;
+
+    while (low < threshold) {
+      m = (next_(stream) >> 32) * (uint64_t)max;
+      low = (uint32_t)m;
+    }  // od
+  }    // fi
+
+  return (uint32_t)(m >> 32);
+}  // roll_with_()
+
+/**
+ *  Fill `out` with `count` rolls of a stream in [0, max), e.g. one
+ *  column of a freshly spawned batch of meteors.
+ *
+ *  @since  0.1.0
+ **/
+void fill_with_(DiceStream *stream, uint32_t max, uint32_t *out, int count) {
+  for (int i = 0; i < count; ++i) {
+    out[i] = roll_with_(stream, max);
+  }  // od
+}  // fill_with_()
+
+/**
+ *  xoshiro256** (Blackman and Vigna): the next 64 random bits.
+ *
+ *  @since  0.1.0
+ **/
+uint64_t next_(DiceStream *stream) {
+  uint64_t *s = stream->s_;
+  uint64_t const result = ((s[1] * 5) << 7 | (s[1] * 5) >> 57) * 9;
+  uint64_t const t = s[1] << 17;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+
+  s[2] ^= t;
+  s[3] = (s[3] << 45) | (s[3] >> 19);
+
+  return result;
+}  // next_()
+
+/**
+ *  Advance a stream by 2^128 draws.
+ *
+ *  @since  0.1.0
+ **/
+void jump_(DiceStream *stream) {
+  static uint64_t const JUMP[] = {
+      0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+      0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL,
+  };
+
+  uint64_t s[4] = {0, 0, 0, 0};
+
+  for (int i = 0; i < 4; ++i) {
+    for (int b = 0; b < 64; ++b) {
+      if (JUMP[i] & ((uint64_t)1 << b)) {
+        s[0] ^= stream->s_[0];
+        s[1] ^= stream->s_[1];
+        s[2] ^= stream->s_[2];
+        s[3] ^= stream->s_[3];
+      }  // fi
+
+      next_(stream);
+    }  // od
+  }    // od
+
+  for (int i = 0; i < 4; ++i) {
+    stream->s_[i] = s[i];
+  }  // od
+}  // jump_()
+
+/**
+ *  splitmix64: the next value of a seed sequence.
+ *
+ *  @since  0.1.0
+ **/
+uint64_t splitmix_(uint64_t *x) {
+  uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+  return z ^ (z >> 31);
+}  // splitmix_()
 
 // dice.c
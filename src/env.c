@@ -0,0 +1,480 @@
+/**
+ *  @file       env.c
+ *  @brief      Defines the batch environment.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The batch environment.  The worlds of a batch are stepped in
+ *  parallel, ENV_GRAIN of them per job, each on its own thread only;
+ *  since every world rolls its own dice stream, the result does not
+ *  depend on the number of threads.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "env.h"
+#include "laser.h"
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static void init_(EnvBatch *, EnvConfig const *, WorldHooks const *);
+static void release_(EnvBatch *);
+static void reset_(EnvBatch *, EnvOutput const *);
+static void step_(EnvBatch *, Input const *, EnvOutput const *);
+static int entity_floats_(EnvBatch const *);
+
+static uint64_t seed_of_(EnvBatch const *, int);
+static void parallel_for_(EnvBatch *, SimRange);
+static void reset_range_(void *, int, int, int);
+static void step_range_(void *, int, int, int);
+
+static void observe_(EnvBatch const *, int);
+static void observe_entities_(EnvBatch const *, World const *, float *);
+static void observe_grid_(EnvBatch const *, World const *, uint8_t *);
+static void mark_(EnvBatch const *, World const *, uint8_t *, Rect const *,
+                  uint8_t);
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global VecEnv object.
+ *
+ *  @since  0.1.0
+ **/
+VecEnv vec_env = {
+    init_, release_, reset_, step_, entity_floats_,
+};  // vec_env
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Make the `count_` worlds of a batch, each in its first episode.
+ *  The worlds step serially inside; `hooks` only spreads the worlds
+ *  over threads.
+ *
+ *  @param EnvBatch * the batch to initialize.
+ *  @param EnvConfig const * what to make it from.
+ *  @param WorldHooks const * the host's hooks, or NULL for none.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void init_(EnvBatch *batch, EnvConfig const *config,
+           WorldHooks const *hooks) {
+  extern Simulator simulator;
+
+  WorldConfig world;
+
+  if ((config->count_ < 1) || (config->nearest_ < 0) ||
+      (config->nearest_ > ENV_NEAREST_MAX) || (config->grid_w_ < 0) ||
+      (config->grid_h_ < 0)) {
+    printf("Env Error: %d worlds, %d nearest meteors, %d x %d grid\n",
+           config->count_, config->nearest_, config->grid_w_,
+           config->grid_h_);
+    exit(-1);
+  }  // fi
+
+  batch->config_ = *config;
+
+  // 每個 world 的 laser pool 各自配置, 預設給小一點
+  if (batch->config_.world_.lasers_ < 1) {
+    batch->config_.world_.lasers_ = ENV_LASERS;
+  }  // fi
+
+  memset(&batch->hooks_, 0, sizeof(WorldHooks));
+
+  if (hooks != (WorldHooks const *)NULL) {
+    batch->hooks_ = *hooks;
+  }  // fi
+
+  batch->worlds_ = (World *)calloc(config->count_, sizeof(World));
+  batch->episodes_ = (uint32_t *)calloc(config->count_, sizeof(uint32_t));
+
+  batch->actions_ = (Input const *)NULL;
+  batch->out_ = (EnvOutput const *)NULL;
+
+  world = batch->config_.world_;
+
+  for (int i = 0; i < config->count_; ++i) {
+    world.seed_ = seed_of_(batch, i);
+
+    simulator.init(&batch->worlds_[i], &world, (WorldHooks const *)NULL);
+  }  // od
+}  // init_()
+
+/**
+ *  Free the worlds of a batch.
+ *
+ *  @since  0.1.0
+ **/
+void release_(EnvBatch *batch) {
+  extern Simulator simulator;
+
+  for (int i = 0; i < batch->config_.count_; ++i) {
+    simulator.release(&batch->worlds_[i]);
+  }  // od
+
+  free(batch->worlds_);
+  free(batch->episodes_);
+
+  batch->worlds_ = (World *)NULL;
+  batch->episodes_ = (uint32_t *)NULL;
+}  // release_()
+
+/**
+ *  Start a new episode in every world and write the first
+ *  observations; rewards and done flags are all 0.
+ *
+ *  @param EnvBatch * the batch.
+ *  @param EnvOutput const * where to write.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void reset_(EnvBatch *batch, EnvOutput const *out) {
+  batch->out_ = out;
+
+  parallel_for_(batch, reset_range_);
+
+  batch->out_ = (EnvOutput const *)NULL;
+}  // reset_()
+
+/**
+ *  Step every world one tick with its action, `actions[i]` for world
+ *  i, and write the rewards, done flags and observations.  A world
+ *  done after this tick is already reset: its observation is the
+ *  first of its next episode.
+ *
+ *  @param EnvBatch * the batch.
+ *  @param Input const * one action per world.
+ *  @param EnvOutput const * where to write.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void step_(EnvBatch *batch, Input const *actions, EnvOutput const *out) {
+  batch->actions_ = actions;
+  batch->out_ = out;
+
+  parallel_for_(batch, step_range_);
+
+  batch->actions_ = (Input const *)NULL;
+  batch->out_ = (EnvOutput const *)NULL;
+}  // step_()
+
+/**
+ *  The number of floats of one world's entity observation.
+ *
+ *  @since  0.1.0
+ **/
+int entity_floats_(EnvBatch const *batch) {
+  return ENV_SHIP_FLOATS + batch->config_.nearest_ * ENV_METEOR_FLOATS;
+}  // entity_floats_()
+
+/**
+ *  The seed of world i's current episode.
+ *
+ *  @since  0.1.0
+ **/
+uint64_t seed_of_(EnvBatch const *batch, int i) {
+  EnvConfig const *config = &batch->config_;
+
+  return config->world_.seed_ +
+         (uint64_t)batch->episodes_[i] * (uint64_t)config->count_ +
+         (uint64_t)i;
+}  // seed_of_()
+
+/**
+ *  Run `body` over all the worlds with the host's parallel_for, or on
+ *  this thread.
+ *
+ *  @since  0.1.0
+ **/
+void parallel_for_(EnvBatch *batch, SimRange body) {
+  if (batch->hooks_.parallel_for != NULL) {
+    batch->hooks_.parallel_for(batch->config_.count_, ENV_GRAIN, body,
+                               (void *)batch);
+  }  // fi
+  else {
+    body((void *)batch, 0, batch->config_.count_, 0);
+  }  // esle
+}  // parallel_for_()
+
+/**
+ *  Reset the worlds [begin, end) to their next episode.
+ *
+ *  @param void * the EnvBatch.
+ *  @since  0.1.0
+ **/
+void reset_range_(void *context, int begin, int end, int worker) {
+  extern Simulator simulator;
+
+  EnvBatch *batch = (EnvBatch *)context;
+  EnvOutput const *out = batch->out_;
+
+  (void)worker;
+
+  for (int i = begin; i < end; ++i) {
+    batch->episodes_[i] += 1;
+    simulator.reset(&batch->worlds_[i], seed_of_(batch, i));
+
+    out->reward_[i] = 0.0f;
+    out->done_[i] = 0;
+
+    observe_(batch, i);
+  }  // od
+}  // reset_range_()
+
+/**
+ *  Step the worlds [begin, end) and score the tick: every meteor shot
+ *  down, every point of damage and the loss of the last ship.
+ *
+ *  @param void * the EnvBatch.
+ *  @since  0.1.0
+ **/
+void step_range_(void *context, int begin, int end, int worker) {
+  extern Simulator simulator;
+
+  EnvBatch *batch = (EnvBatch *)context;
+  EnvOutput const *out = batch->out_;
+  int const max_ticks = batch->config_.max_ticks_;
+
+  (void)worker;
+
+  for (int i = begin; i < end; ++i) {
+    World *world = &batch->worlds_[i];
+    float reward = 0.0f;
+    bool done = false;
+
+    simulator.step(world, &batch->actions_[i]);
+
+    reward = world->kills_ * ENV_REWARD_KILL + world->damage_ * ENV_REWARD_HIT;
+
+    if (!world->wings_.alive) {
+      reward += ENV_REWARD_DEAD;
+      done = true;
+    }  // fi
+
+    if ((max_ticks > 0) && (world->tick_ >= (uint32_t)max_ticks)) {
+      done = true;
+    }  // fi
+
+    // 自動重置, 整批 world 不必等待
+    if (done) {
+      batch->episodes_[i] += 1;
+      simulator.reset(world, seed_of_(batch, i));
+    }  // fi
+
+    out->reward_[i] = reward;
+    out->done_[i] = done ? 1 : 0;
+
+    observe_(batch, i);
+  }  // od
+}  // step_range_()
+
+/**
+ *  Write the observations of world i that the caller asked for.
+ *
+ *  @since  0.1.0
+ **/
+void observe_(EnvBatch const *batch, int i) {
+  EnvOutput const *out = batch->out_;
+  World const *world = &batch->worlds_[i];
+
+  if (out->entities_ != (float *)NULL) {
+    observe_entities_(batch, world,
+                      out->entities_ + (size_t)i * entity_floats_(batch));
+  }  // fi
+
+  if (out->grid_ != (uint8_t *)NULL) {
+    size_t cells = (size_t)batch->config_.grid_w_ * batch->config_.grid_h_;
+
+    observe_grid_(batch, world, out->grid_ + (size_t)i * cells);
+  }  // fi
+}  // observe_()
+
+/**
+ *  The ship and the `nearest_` visible meteors nearest it, kept in a
+ *  short sorted list while the meteors are scanned once.
+ *
+ *  @since  0.1.0
+ **/
+void observe_entities_(EnvBatch const *batch, World const *world,
+                       float *obs) {
+  Scene const *scene = &world->scene_;
+  MeteorStore const *meteors = &scene->meteors_;
+  Wings const *wings = &world->wings_;
+  Shape const *ship = &world->config_.ship_;
+
+  float const w = (float)scene->box_.w;
+  float const h = (float)scene->box_.h;
+  int const nearest = batch->config_.nearest_;
+
+  // 以戰機的中心為原點
+  int const cx = wings->position_.x + ship->w_ / 2;
+  int const cy = wings->position_.y + ship->h_ / 2;
+
+  int32_t near[ENV_NEAREST_MAX];
+  int64_t distance[ENV_NEAREST_MAX];
+  int found = 0;
+
+  obs[0] = wings->position_.x / w;
+  obs[1] = wings->position_.y / h;
+  obs[2] = wings->health / 100.0f;
+  obs[3] = (float)wings->num_life;
+
+  for (int i = 0; (nearest > 0) && (i < meteors->count_); ++i) {
+    int64_t dx = 0;
+    int64_t dy = 0;
+    int64_t d = 0;
+    int k = 0;
+
+    if (!(meteors->flags_[i] & METEOR_VISIBLE)) {
+      continue;
+    }  // fi
+
+    dx = meteors->x_[i] + meteors->w_[i] / 2 - cx;
+    dy = meteors->y_[i] + meteors->h_[i] / 2 - cy;
+    d = dx * dx + dy * dy;
+
+    if ((found == nearest) && (d >= distance[nearest - 1])) {
+      continue;
+    }  // fi
+
+    // 插入排序; 距離相同時, index 小的在前
+    k = (found < nearest) ? found++ : nearest - 1;
+
+    while ((k > 0) && (distance[k - 1] > d)) {
+      distance[k] = distance[k - 1];
+      near[k] = near[k - 1];
+      k -= 1;
+    }  // od
+
+    distance[k] = d;
+    near[k] = i;
+  }  // od
+
+  for (int k = 0; k < nearest; ++k) {
+    float *meteor = obs + ENV_SHIP_FLOATS + k * ENV_METEOR_FLOATS;
+
+    if (k < found) {
+      int i = near[k];
+
+      meteor[0] = 1.0f;
+      meteor[1] = (meteors->x_[i] + meteors->w_[i] / 2 - cx) / w;
+      meteor[2] = (meteors->y_[i] + meteors->h_[i] / 2 - cy) / h;
+      meteor[3] = meteors->vx_[i] / (float)WINGS_STEP;
+      meteor[4] = meteors->vy_[i] / (float)WINGS_STEP;
+    }  // fi
+    else {
+      memset(meteor, 0, sizeof(float) * ENV_METEOR_FLOATS);
+    }  // esle
+  }    // od
+}  // observe_entities_()
+
+/**
+ *  Downsample the scene into `grid_w_ * grid_h_` cells, marking what
+ *  covers each: visible meteors, live lasers and the ship.
+ *
+ *  @since  0.1.0
+ **/
+void observe_grid_(EnvBatch const *batch, World const *world,
+                   uint8_t *cells) {
+  extern LaserAllocator laser_allocator;
+
+  Scene const *scene = &world->scene_;
+  MeteorStore const *meteors = &scene->meteors_;
+  LaserPool const *pool = &scene->lasers_;
+  Wings const *wings = &world->wings_;
+  Rect box;
+
+  memset(cells, 0,
+         (size_t)batch->config_.grid_w_ * batch->config_.grid_h_);
+
+  for (int i = 0; i < meteors->count_; ++i) {
+    if (meteors->flags_[i] & METEOR_VISIBLE) {
+      box.x = meteors->x_[i];
+      box.y = meteors->y_[i];
+      box.w = meteors->w_[i];
+      box.h = meteors->h_[i];
+
+      mark_(batch, world, cells, &box, ENV_CELL_METEOR);
+    }  // fi
+  }    // od
+
+  for (int j = 0; j < pool->count_; ++j) {
+    mark_(batch, world, cells, &laser_allocator.at(pool, j)->box_,
+          ENV_CELL_LASER);
+  }  // od
+
+  box.x = wings->position_.x;
+  box.y = wings->position_.y;
+  box.w = world->config_.ship_.w_;
+  box.h = world->config_.ship_.h_;
+
+  mark_(batch, world, cells, &box, ENV_CELL_SHIP);
+}  // observe_grid_()
+
+/**
+ *  Set `bit` in every cell `box` covers; the parts of `box` outside
+ *  the scene are ignored.
+ *
+ *  @since  0.1.0
+ **/
+void mark_(EnvBatch const *batch, World const *world, uint8_t *cells,
+           Rect const *box, uint8_t bit) {
+  int const gw = batch->config_.grid_w_;
+  int const gh = batch->config_.grid_h_;
+  int const w = world->scene_.box_.w;
+  int const h = world->scene_.box_.h;
+
+  int x0 = (box->x > 0) ? box->x : 0;
+  int y0 = (box->y > 0) ? box->y : 0;
+  int x1 = (box->x + box->w < w) ? box->x + box->w : w;
+  int y1 = (box->y + box->h < h) ? box->y + box->h : h;
+
+  if ((x0 >= x1) || (y0 >= y1)) {
+    return;
+  }  // fi
+
+  // 像素座標換成格子座標, [x0, x1) 涵蓋的格子
+  x0 = (int)((int64_t)x0 * gw / w);
+  y0 = (int)((int64_t)y0 * gh / h);
+  x1 = (int)(((int64_t)x1 * gw + w - 1) / w);
+  y1 = (int)(((int64_t)y1 * gh + h - 1) / h);
+
+  for (int y = y0; y < y1; ++y) {
+    for (int x = x0; x < x1; ++x) {
+      cells[y * gw + x] |= bit;
+    }  // od
+  }    // od
+}  // mark_()
+
+// env.c
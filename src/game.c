@@ -41,14 +41,28 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <time.h>
 
 #include <SDL2/SDL_image.h>
 
-#include "dice.h"
+#include "atlas.h"
+#include "batch.h"
+#include "collide.h"
+#include "jobs.h"
+#include "laser.h"
 
 #include "game.h"
+#include "options.h"
+#include "pack.h"
+#include "profile.h"
+#include "registry.h"
+#include "replay.h"
+#include "shm.h"
+#include "sim.h"
+#include "snapshot.h"
+#include "trace.h"
 
 // 內部函數 (private functions) 的前置宣告 (forward declarations)
 static void game_init_(void);
@@ -57,35 +71,87 @@ static void game_over_(void);
 static void game_start_(void);
 
 static void init_sdl_(void);
-static Sprite *load_image_(char const *);
-static void update_(void);
+static void request_image_(char const *, Sprite **);
+static void load_images_(void);
+static void decode_images_(void *, int, int, int);
+static void pack_image_(Sprite *, SDL_Surface *, char const *);
+static void show_progress_(int, int);
+static void load_mask_(Sprite *, SDL_Surface *);
+static void bake_atlas_(void);
+static void update_(Snapshot const *, float);
+static void draw_sprite_(Sprite const *, SDL_Rect const *);
+static int lerp_(int, int, float);
+static void sdl_rect_(Rect const *, SDL_Rect *);
+
+static void init_skin_(Skin *);
+static void release_skin_(Skin *);
+static void release_sprites_(Sprite **, int);
+static void init_world_(uint64_t);
+static void shape_(Sprite const *, Shape *);
+#ifdef UXI_TRACE
+static void world_phase_(SimPhase, bool, uint32_t);
+#endif
+
+static void update_scene_(Snapshot const *, float);
+static void update_wings_(Uint32, SDL_Point const *);
+static void update_wings_damage_(int, SDL_Point const *);
+
+static void step_(Input const *);
+static void capture_(Snapshot *);
+static void share_frame_(Uint32);
+static bool next_input_(Input *, uint32_t *);
+static int simulate_(void *);
 
-static void init_meteors_(Scene *);
-static void init_meteor_sprites_(Scene *);
-static Scene *init_scene_(void);
-static Wings *init_wings_(void);
+// 內部資料欄位 (private data) 宣告
+static SDL_Renderer *renderer_ = (SDL_Renderer *)NULL;
+static SDL_Window *window_ = (SDL_Window *)NULL;
+static SDL_Surface *target_ = (SDL_Surface *)NULL;  // headless 的畫布
 
-static void laser_destroy_(Laser *);
+static SpriteBatch batch_;
 
-static void update_lasers_(void);
-static void update_meteors_(void);
-static void update_scene_(void);
-static void update_wings_(void);
-static void update_wings_damage_(int);
-static void collide_wings_(void);
+static World world_;  // 模擬的世界, 只有模擬執行緒會改動
+static Skin skin_;    // 繪出世界用的 sprite
 
-static void vector_assign_(SDL_Point *, SDL_Point *);
-static void vector_neg_(SDL_Point *);
-static int vector_dot_(SDL_Point *, SDL_Point *);
-static void vector_minus_(SDL_Point *, SDL_Point *, SDL_Point *);
+#ifdef UXI_PROFILE
+#define PROFILE_CSV "profile.csv"  // 結束時寫出各 phase 的計時
 
-static void gjk_support_(SDL_Rect const *, SDL_Point const *, SDL_Point *);
-static bool gjk_simplex_(SDL_Point *, SDL_Point *);
-static bool gjk_collides_(SDL_Rect const *, SDL_Rect const *);
+static Uint32 frames_ = 0;  // 已繪出的畫面數
+static Uint64 phase_at_[SIM_PHASES];  // 世界的各 phase 開始的時間
+#endif
 
-// 內部資料欄位 (private data) 宣告
-static SDL_Renderer *renderer_ = (SDL_Renderer *)NULL;
-static SDL_Window *window_ = (SDL_Window *)NULL;
+// 模擬執行緒與繪圖執行緒 (主執行緒) 之間共用的資料
+static SnapshotQueue snapshots_;
+static SDL_mutex *input_lock_ = (SDL_mutex *)NULL;
+static Input input_;
+static SDL_atomic_t done_;  // 模擬執行緒已結束
+
+// --share: 匯出到共享記憶體, 給外部的工具讀取
+static ShmRing shared_ = {"", false, 0, (ShmHeader *)NULL};
+
+// 錄製與播放的 session
+static Replay recording_ = {(FILE *)NULL, false, 0, 0, 0, 0, 0, 0, false, 0};
+static Replay playback_ = {(FILE *)NULL, false, 0, 0, 0, 0, 0, 0, false, 0};
+
+static Atlas atlas_[ATLAS_PAGES];
+static int atlas_pages_ = 0;
+
+static Registry sprites_;  // 所有載入的 sprite, 依圖檔路徑
+
+// 等待解碼的圖檔, 由 load_images_() 一次平行解碼
+#define LOAD_CAPACITY 64
+#define LOAD_PROGRESS_DELAY 250  // 載入超過此時間 (ms) 才顯示進度
+#define ASSET_PACK "img/img.pack"  // make -f Makefile.linux pack 產生
+
+static Sprite *load_sprites_[LOAD_CAPACITY];
+static SDL_Surface *load_surfaces_[LOAD_CAPACITY];
+static int load_count_ = 0;
+static SDL_atomic_t loaded_;  // 已解碼的圖檔數
+static SDL_atomic_t packed_;  // 其中直接取自 pack 的圖檔數
+static Pack pack_;
+static Uint64 load_start_ = 0;
+
+static Uint64 started_ = 0;     // game_init_() 開始的時間
+static double decode_ms_ = 0.0;  // 解碼所有圖檔的時間
 
 // 公開 (public) 物件的宣告
 
@@ -95,242 +161,455 @@ static SDL_Window *window_ = (SDL_Window *)NULL;
  *  @since  0.1.0
  **/
 Game game = {
-    game_init_, game_over_, game_start_, (Wings *)NULL, (Scene *)NULL,
+    game_init_, game_over_, game_start_, &world_, &skin_,
 };  // game
 
 // 函數 (方法) 的實作 (implementations)
 
 /**
- *  Initialize SDL lib.
+ *  Initialize SDL lib.  In headless mode no window is created: the
+ *  game renders into an offscreen surface of the requested size with
+ *  the software renderer, or does not render at all.
  *
  *  @param none.
  *  @return none.
  *  @since  0.1.0
  **/
 void init_sdl_(void) {
-  if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-    printf("SDL Error: %s\n", SDL_GetError());
-  }  // fi
+  extern Options options;
+  extern SpriteBatcher sprite_batcher;
 
-  SDL_CreateWindowAndRenderer(0, 0, SDL_WINDOW_FULLSCREEN_DESKTOP,
-                              &window_,   // 視窗
-                              &renderer_  // 渲染器
-                              );
+  if (options.headless_) {
+    if (SDL_Init(SDL_INIT_TIMER) < 0) {
+      printf("SDL Error: %s\n", SDL_GetError());
+    }  // fi
 
-  if ((window_ == (SDL_Window *)NULL) || (renderer_ == (SDL_Renderer *)NULL)) {
-    printf("SDL Error: %s\n", SDL_GetError());
-  }  // fi
+    if (options.render_) {
+      target_ = SDL_CreateRGBSurfaceWithFormat(
+          0, options.width_, options.height_, 32, SDL_PIXELFORMAT_ARGB8888);
+
+      if (target_ != (SDL_Surface *)NULL) {
+        renderer_ = SDL_CreateSoftwareRenderer(target_);
+      }  // fi
+
+      if (renderer_ == (SDL_Renderer *)NULL) {
+        printf("SDL Error: %s\n", SDL_GetError());
+      }  // fi
+    }    // fi
+  }      // fi
+  else {
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+      printf("SDL Error: %s\n", SDL_GetError());
+    }  // fi
+
+    // 繪圖與模擬分開, 畫面可以跟著螢幕的更新率 (或不限速) 輸出
+    SDL_SetHint(SDL_HINT_RENDER_VSYNC, options.vsync_ ? "1" : "0");
+
+    SDL_CreateWindowAndRenderer(0, 0, SDL_WINDOW_FULLSCREEN_DESKTOP,
+                                &window_,   // 視窗
+                                &renderer_  // 渲染器
+                                );
+
+    if ((window_ == (SDL_Window *)NULL) ||
+        (renderer_ == (SDL_Renderer *)NULL)) {
+      printf("SDL Error: %s\n", SDL_GetError());
+    }  // fi
+  }    // esle
 
   SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+
+  sprite_batcher.init(&batch_, renderer_, BATCH_CAPACITY);
 }  // init_sdl_()
 
 /**
- *  Load image and return a pointer to the Sprite object in which
- *  the image stored.
+ *  Ask for an image.  *slot gets the image's shared Sprite object at
+ *  once; an image not loaded before is decoded by the next
+ *  load_images_(), so the sprite must not be used until then.
  *
  *  @param char const * the image file name.
- *  @return Sprite * pointer to the Sprite object.
+ *  @param Sprite ** where to store the Sprite object.
+ *  @return none.
  *  @since  0.1.0
  **/
-Sprite *load_image_(char const *f_name) {
-  SDL_Surface *surface = (SDL_Surface *)NULL;
-  Sprite *sprite = (Sprite *)malloc(sizeof(Sprite));
+void request_image_(char const *f_name, Sprite **slot) {
+  extern SpriteRegistry sprite_registry;
 
-  surface = IMG_Load(f_name);
+  bool fresh = false;
 
-  if (surface == (SDL_Surface *)NULL) {
-    printf("SDL Error: %s\n", SDL_GetError());
+  *slot = sprite_registry.acquire(&sprites_, f_name, &fresh);
 
-    exit(-1);
+  // 已載入 (或已在等待) 的圖檔不重複解碼
+  if (!fresh) {
+    return;
   }  // fi
 
-  sprite->texture_ = SDL_CreateTextureFromSurface(renderer_, surface);
-
-  if (sprite->texture_ == (SDL_Texture *)NULL) {
-    printf("SDL Error: %s\n", SDL_GetError());
+  if (load_count_ == LOAD_CAPACITY) {
+    printf("Load Error: too many images, %s\n", f_name);
 
     exit(-1);
   }  // fi
 
-  sprite->rect_.x = 0;
-  sprite->rect_.y = 0;
-  sprite->rect_.w = surface->w;
-  sprite->rect_.h = surface->h;
-
-  SDL_FreeSurface(surface);
+  load_sprites_[load_count_] = *slot;
+  load_surfaces_[load_count_] = (SDL_Surface *)NULL;
 
-  return sprite;
-}  // load_image_()
+  ++load_count_;
+}  // request_image_()
 
 /**
- *  Update lasers' position.
+ *  Load every requested image.  Images found in the baked asset pack
+ *  are used as mapped; the rest are decoded from their PNG files.
+ *  Both (and the collision masks) run on the job system's workers;
+ *  the surfaces are then packed into the atlas in request order on
+ *  this thread, so the atlas layout does not depend on the number of
+ *  threads.  Uploading the atlas is left to bake_atlas_().
  *
- *  @param none.
- *  @return none.
  *  @since  0.1.0
  **/
-void update_lasers_(void) {
-  Laser *laser = (Laser *)NULL;
+void load_images_(void) {
+  extern AssetPack asset_pack;
+  extern JobSystem job_system;
+  extern Trace trace;
+
+  // 沒有 pack (或已過期) 時全部由 PNG 解碼
+  asset_pack.open(&pack_, ASSET_PACK);
 
-  laser = game.scene->lasers_;
+  // 先在這個執行緒初始化 PNG 解碼器, 各 worker 才能同時使用
+  IMG_Init(IMG_INIT_PNG);
 
-  Uint32 now;
-  now = SDL_GetTicks();
+  SDL_AtomicSet(&loaded_, 0);
+  SDL_AtomicSet(&packed_, 0);
+  load_start_ = SDL_GetPerformanceCounter();
 
-  while (laser != (Laser *)NULL) {
-    if (laser->exploding) {
-      if (laser->exploding_idx < 11) {
-        laser->sprite_ = game.wings->laser_sprites_[laser->exploding_idx];
-      }
-      laser->exploding_idx = laser->exploding_idx + 1;
-    } else {
-      laser->idx = (laser->idx + 1) % 7;
-      laser->sprite_ = game.wings->laser_sprites_[laser->idx];
-    }
+  trace.begin("load_images");
 
-    laser->box_.y -= laser->velocity_;
+  job_system.parallel_for(load_count_, 1, decode_images_, (void *)NULL);
 
-    if (laser->box_.y < 0 || laser->exploding_idx >= 11) {
-      Laser *tmp = laser->next_;
+  for (int i = 0; i < load_count_; ++i) {
+    Sprite *sprite = load_sprites_[i];
 
-      laser_destroy_(laser);
+    if (load_surfaces_[i] == (SDL_Surface *)NULL) {
+      printf("Load Error: cannot decode %s\n", sprite->name_);
 
-      laser = tmp;
+      exit(-1);
+    }  // fi
+
+    pack_image_(sprite, load_surfaces_[i], sprite->name_);
+
+    SDL_FreeSurface(load_surfaces_[i]);
+  }  // od
+
+  // pack 中的像素已複製進 atlas page
+  asset_pack.close(&pack_);
+
+  trace.end("load_images");
+
+  decode_ms_ = (double)(SDL_GetPerformanceCounter() - load_start_) * 1000.0 /
+               (double)SDL_GetPerformanceFrequency();
+
+  load_count_ = 0;
+}  // load_images_()
+
+/**
+ *  Load the requested images [begin, end), from the pack or else by
+ *  decoding the PNG, and build their masks.
+ *  Runs on any worker; worker 0 is the main thread, which also shows
+ *  the progress.
+ *
+ *  @since  0.1.0
+ **/
+void decode_images_(void *context, int begin, int end, int worker) {
+  extern AssetPack asset_pack;
+  extern Trace trace;
+
+  (void)context;
+
+  for (int i = begin; i < end; ++i) {
+    char const *f_name = load_sprites_[i]->name_;
+    SDL_Surface *surface = (SDL_Surface *)NULL;
+
+    trace.begin(f_name);
+
+    surface = asset_pack.surface(&pack_, f_name);
+
+    if (surface != (SDL_Surface *)NULL) {
+      SDL_AtomicAdd(&packed_, 1);
     }  // fi
     else {
-      laser = laser->next_;
+      surface = IMG_Load(f_name);
     }  // esle
-  }    // od
-}  // update_lasers_()
+
+    // 錯誤留給 load_images_() 回報
+    if (surface != (SDL_Surface *)NULL) {
+      load_mask_(load_sprites_[i], surface);
+    }  // fi
+
+    load_surfaces_[i] = surface;
+
+    trace.end(f_name);
+
+    SDL_AtomicAdd(&loaded_, 1);
+
+    if (worker == 0) {
+      show_progress_(SDL_AtomicGet(&loaded_), load_count_);
+    }  // fi
+  }  // od
+}  // decode_images_()
 
 /**
- *  Update meteors' position.
+ *  Show the loading progress, once loading takes longer than
+ *  LOAD_PROGRESS_DELAY: a bar on the screen, or a line on the
+ *  console without a renderer.
  *
- *  @param none.
+ *  @param int images decoded.
+ *  @param int images requested.
+ *  @since  0.1.0
+ **/
+void show_progress_(int done, int total) {
+  Uint64 elapsed = SDL_GetPerformanceCounter() - load_start_;
+
+  int width = 0;
+  int height = 0;
+  SDL_Rect bar;
+
+  if (elapsed * 1000 < SDL_GetPerformanceFrequency() * LOAD_PROGRESS_DELAY) {
+    return;
+  }  // fi
+
+  if (renderer_ == (SDL_Renderer *)NULL) {
+    printf("Loading %d/%d\n", done, total);
+
+    return;
+  }  // fi
+
+  SDL_GetRendererOutputSize(renderer_, &width, &height);
+
+  // 畫面中間的進度條
+  bar.w = width / 2;
+  bar.h = 8;
+  bar.x = (width - bar.w) / 2;
+  bar.y = (height - bar.h) / 2;
+
+  SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255);
+  SDL_RenderClear(renderer_);
+
+  SDL_SetRenderDrawColor(renderer_, 64, 64, 64, 255);
+  SDL_RenderFillRect(renderer_, &bar);
+
+  bar.w = bar.w * done / total;
+
+  SDL_SetRenderDrawColor(renderer_, 255, 255, 255, 255);
+  SDL_RenderFillRect(renderer_, &bar);
+
+  SDL_RenderPresent(renderer_);
+}  // show_progress_()
+
+/**
+ *  Pack a decoded image into the atlas, opening a new page when the
+ *  current one is full.
+ *
+ *  @param Sprite * the sprite of the image.
+ *  @param SDL_Surface * the decoded image.
+ *  @param char const * the image file name, for errors.
  *  @return none.
  *  @since  0.1.0
  **/
-void update_meteors_(void) {
-  extern Dice dice;
+void pack_image_(Sprite *sprite, SDL_Surface *surface, char const *f_name) {
+  extern AtlasPacker atlas_packer;
 
-  Meteor *meteors = (Meteor *)NULL;
-  Scene *scene = (Scene *)NULL;
+  // 將圖片放入 atlas, 目前的 page 滿了就開新的一頁;
+  // texture_ 在 bake_atlas_() 時才會設定
+  if (atlas_pages_ == 0 ||
+      !atlas_packer.pack(&atlas_[atlas_pages_ - 1], sprite, surface)) {
+    if (atlas_pages_ == ATLAS_PAGES) {
+      printf("Atlas Error: no room for %s\n", f_name);
 
-  scene = game.scene;
+      exit(-1);
+    }  // fi
 
-  for (int i = 0; i < scene->obj_counts_; ++i) {
-    meteors = scene->meteors_;
+    atlas_packer.open(&atlas_[atlas_pages_++], ATLAS_PAGE_SIZE,
+                      ATLAS_PAGE_SIZE);
 
-    meteors[i].box_.y += meteors[i].velocity_;
-    meteors[i].box_.x += meteors[i].velocitx_;
+    if (!atlas_packer.pack(&atlas_[atlas_pages_ - 1], sprite, surface)) {
+      printf("Atlas Error: %s does not fit in a page\n", f_name);
 
-    if (meteors[i].box_.y > scene->box_.h ||
-        (meteors[i].box_.x + meteors[i].box_.w) < 0 ||
-        meteors[i].box_.x > scene->box_.w) {
-      int tmp = meteors[i].box_.x / 256;
+      exit(-1);
+    }  // fi
+  }    // fi
+}  // pack_image_()
+
+/**
+ *  Build the sprite's 1-bit collision mask from the surface's alpha
+ *  channel.  Pixels at least half opaque are solid.
+ *
+ *  @param Sprite * the sprite to which the mask belongs.
+ *  @param SDL_Surface * the decoded image.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void load_mask_(Sprite *sprite, SDL_Surface *surface) {
+  extern Collide collide;
+
+  SDL_Surface *rgba = (SDL_Surface *)NULL;
+  Bitmask *mask = &sprite->mask_;
+
+  rgba = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
 
-      meteors[i].box_.x = dice.roll(128) + tmp * 256;
-      meteors[i].box_.y = 0 - meteors[i].box_.h;
-      meteors[i].velocity_ = dice.roll(3) + 1;
+  if (rgba == (SDL_Surface *)NULL) {
+    printf("SDL Error: %s\n", SDL_GetError());
 
-      if ((dice.roll(100) % 2) == 0) {
-        meteors[i].visible_ = true;
-        meteors[i].velocitx_ *= -1;
+    exit(-1);
+  }  // fi
+
+  collide.mask_alloc(mask, rgba->w, rgba->h);
+
+  SDL_LockSurface(rgba);
+
+  for (int y = 0; y < rgba->h; ++y) {
+    Uint8 const *row = (Uint8 const *)rgba->pixels + y * rgba->pitch;
+    uint64_t *bits = mask->bits_ + y * mask->words_;
+
+    for (int x = 0; x < rgba->w; ++x) {
+      if (row[x * 4 + 3] >= 128) {
+        bits[x >> 6] |= (uint64_t)1 << (x & 63);
       }  // fi
-      else {
-        meteors[i].visible_ = false;
-      }  // esle
+    }    // od
+  }      // od
 
-      tmp = dice.roll(scene->sprite_counts_);
+  SDL_UnlockSurface(rgba);
+  SDL_FreeSurface(rgba);
+}  // load_mask_()
 
-      meteors[i].sprite_ = scene->meteor_sprites_[tmp];
+/**
+ *  Upload every atlas page.  Called once all images are loaded.
+ *
+ *  @since  0.1.0
+ **/
+void bake_atlas_(void) {
+  extern AtlasPacker atlas_packer;
+
+  // 不繪圖時不需要 texture, 直接釋放 atlas 的像素
+  if (renderer_ == (SDL_Renderer *)NULL) {
+    for (int i = 0; i < atlas_pages_; ++i) {
+      atlas_packer.close(&atlas_[i]);
+    }  // od
+
+    return;
+  }  // fi
+
+  for (int i = 0; i < atlas_pages_; ++i) {
+    if (!atlas_packer.bake(&atlas_[i], renderer_)) {
+      printf("SDL Error: %s\n", SDL_GetError());
+
+      exit(-1);
     }  // fi
   }    // od
-}  // update_meteors_()
+}  // bake_atlas_()
 
 /**
- *  Paint the Scene object to the screen.
+ *  Queue a sprite to be drawn at dst.  Sprites are batched and
+ *  reach the renderer when update_() flushes the batch.
  *
- *  @param none.
+ *  @since  0.1.0
+ **/
+void draw_sprite_(Sprite const *sprite, SDL_Rect const *dst) {
+  extern SpriteBatcher sprite_batcher;
+
+  sprite_batcher.draw(&batch_, sprite->texture_, SDL_BLENDMODE_BLEND,
+                      &sprite->rect_, dst);
+}  // draw_sprite_()
+
+/**
+ *  Interpolate between the previous and the current tick's value.
+ *
+ *  @param int the value at the previous tick.
+ *  @param int the value at the current tick.
+ *  @param float how far (0 .. 1) the frame is into the next tick.
+ *  @return int the interpolated value.
+ *  @since  0.1.0
+ **/
+int lerp_(int from, int to, float alpha) {
+  return from + (int)((to - from) * alpha);
+}  // lerp_()
+
+/**
+ *  Copy a world Rect into an SDL_Rect.
+ *
+ *  @since  0.1.0
+ **/
+void sdl_rect_(Rect const *rect, SDL_Rect *sdl) {
+  sdl->x = rect->x;
+  sdl->y = rect->y;
+  sdl->w = rect->w;
+  sdl->h = rect->h;
+}  // sdl_rect_()
+
+/**
+ *  Paint the Scene object to the screen.  Meteors and lasers are
+ *  drawn between their previous and current tick positions.
+ *
+ *  @param Snapshot const * the world to draw.
+ *  @param float how far (0 .. 1) the frame is into the next tick.
  *  @return none.
  *  @since  0.1.0
  **/
-void update_scene_(void) {
-  Laser *laser = (Laser *)NULL;
-  Meteor *meteors = (Meteor *)NULL;
-  Scene *scene = game.scene;
+void update_scene_(Snapshot const *snapshot, float alpha) {
+  Pose const *pose = (Pose const *)NULL;
   SDL_Rect dst;
 
   // Render the background texture to the screen
-  SDL_RenderCopy(renderer_, scene->sprite_->texture_, (SDL_Rect *)NULL,
-                 (SDL_Rect *)NULL);
+  sdl_rect_(&world_.scene_.box_, &dst);
+  draw_sprite_(skin_.background_, &dst);
 
-  meteors = scene->meteors_;
+  for (int i = 0; i < snapshot->meteor_count_; ++i) {
+    pose = &snapshot->meteors_[i];
 
-  for (int i = 0; i < scene->obj_counts_; ++i) {
-    if (meteors[i].visible_) {
-      dst.x = meteors[i].box_.x;
-      dst.y = meteors[i].box_.y;
-      dst.w = meteors[i].box_.w;
-      dst.h = meteors[i].box_.h;
+    dst = pose->box_;
+    dst.x = lerp_(dst.x - pose->dx_, dst.x, alpha);
+    dst.y = lerp_(dst.y - pose->dy_, dst.y, alpha);
 
-      SDL_RenderCopy(renderer_, meteors[i].sprite_->texture_, (SDL_Rect *)NULL,
-                     &dst);
-    }  // fi
-  }    // od
-
-  laser = scene->lasers_;
-
-  Uint32 now;
-  now = SDL_GetTicks();
+    draw_sprite_(pose->sprite_, &dst);
+  }  // od
 
-  while (laser != (Laser *)NULL) {
-    dst.x = laser->box_.x;
-    dst.y = laser->box_.y;
-    dst.w = laser->box_.w;
-    dst.h = laser->box_.h;
+  for (int i = 0; i < snapshot->laser_count_; ++i) {
+    pose = &snapshot->lasers_[i];
 
-    if (laser->visible_) {
-      SDL_RenderCopy(renderer_, laser->sprite_->texture_, (SDL_Rect *)NULL,
-                     &dst);
-    }
+    dst = pose->box_;
+    dst.y = lerp_(dst.y - pose->dy_, dst.y, alpha);
 
-    laser = laser->next_;
+    draw_sprite_(pose->sprite_, &dst);
   }  // od
 }  // update_scene_()
 
 /**
  *  Paint the Wings object to the screen.
  *
- *  @param none.
+ *  @param Uint32 the tick being drawn, picks the flame frame.
+ *  @param SDL_Point const * the (interpolated) position to draw at.
  *  @return none.
  *  @since  0.1.0
  **/
-void update_wings_(void) {
-  static int frame = 0;
-
+void update_wings_(Uint32 tick, SDL_Point const *position) {
   SDL_Rect dst;
 
-  Wings *wings = game.wings;
+  Sprite const *ship = skin_.ship_;
 
-  dst.x = wings->position_.x;
-  dst.y = wings->position_.y;
-  dst.w = wings->sprite_->rect_.w;
-  dst.h = wings->sprite_->rect_.h;
+  // 噴燄動畫跟著模擬的 tick 走, 不受畫面更新率影響
+  int frame = tick % 8;
 
-  // Render the wings' texture to the screen
-  SDL_RenderCopy(renderer_, wings->sprite_->texture_, (SDL_Rect *)NULL, &dst);
+  dst.x = position->x;
+  dst.y = position->y;
+  dst.w = ship->rect_.w;
+  dst.h = ship->rect_.h;
 
-  dst.x = wings->position_.x +
-          (wings->sprite_->rect_.w - wings->fire_[frame]->rect_.w) / 2;
-  dst.y = wings->position_.y + wings->sprite_->rect_.h;
-  dst.w = wings->fire_[frame]->rect_.w;
-  dst.h = wings->fire_[frame]->rect_.h;
+  // Render the wings' texture to the screen
+  draw_sprite_(ship, &dst);
 
-  SDL_RenderCopy(renderer_, wings->fire_[frame]->texture_, (SDL_Rect *)NULL,
-                 &dst);
+  dst.x = position->x + (ship->rect_.w - skin_.fire_[frame]->rect_.w) / 2;
+  dst.y = position->y + ship->rect_.h;
+  dst.w = skin_.fire_[frame]->rect_.w;
+  dst.h = skin_.fire_[frame]->rect_.h;
 
-  frame = (frame + 1) % 8;
+  draw_sprite_(skin_.fire_[frame], &dst);
 }  // update_wings_()
 
 /**
@@ -339,699 +618,855 @@ void update_wings_(void) {
  *
  *  @since  0.1.0
  **/
-void update_wings_damage_(int level) {
+void update_wings_damage_(int level, SDL_Point const *position) {
   SDL_Rect dst;
 
-  Wings *wings = game.wings;
-
-  dst.x = wings->position_.x;
-  dst.y = wings->position_.y;
-  dst.w = wings->sprite_->rect_.w;
-  dst.h = wings->sprite_->rect_.h;
+  dst.x = position->x;
+  dst.y = position->y;
+  dst.w = skin_.ship_->rect_.w;
+  dst.h = skin_.ship_->rect_.h;
 
   // Render the wings' shatters texture to the screen
-  SDL_RenderCopy(renderer_, wings->damages_[level]->texture_, (SDL_Rect *)NULL,
-                 &dst);
+  draw_sprite_(skin_.damages_[level], &dst);
 }  // update_wings_damage_()
 
 /**
- *  Update screen.
+ *  Update screen.  The frame shows the snapshot `alpha` of the way
+ *  from its previous tick to its own.  Only the snapshot and the
+ *  (immutable) sprites are read, so the simulation may run at the
+ *  same time.
  *
+ *  @param Snapshot const * the world to draw.
+ *  @param float how far (0 .. 1) the frame is into the next tick.
  *  @since  0.1.0
  **/
-void update_(void) {
+void update_(Snapshot const *snapshot, float alpha) {
+  extern JobSystem job_system;
+  extern SpriteBatcher sprite_batcher;
+
+  SDL_Point position;
+
+  // headless=none: 不繪圖
+  if (renderer_ == (SDL_Renderer *)NULL) {
+    return;
+  }  // fi
+
+  PROFILE_BEGIN(PHASE_FRAME);
+
   // Clear screen
   SDL_RenderClear(renderer_);
 
   // update the background 更新背景
-  update_scene_();
+  PROFILE_BEGIN(PHASE_UPDATE_SCENE);
+  update_scene_(snapshot, alpha);
+  PROFILE_END(PHASE_UPDATE_SCENE, frames_);
+
+  position.x = lerp_(snapshot->wings_last_.x, snapshot->wings_.x, alpha);
+  position.y = lerp_(snapshot->wings_last_.y, snapshot->wings_.y, alpha);
 
   // update the wings 更新使用者戰機
-  update_wings_();
+  update_wings_(snapshot->tick_, &position);
 
-  if (game.wings->health != 100) {
-    update_wings_damage_((100 - game.wings->health) / 30);
+  if (snapshot->health_ != 100) {
+    update_wings_damage_((100 - snapshot->health_) / 30, &position);
   }  // fi
 
+  // 送出尚在 batch 中的 sprites
+  sprite_batcher.flush(&batch_);
+
+#ifdef UXI_PROFILE
+  profiler.draw(renderer_);
+#endif
+
+  // --share-frames: present 前, 畫面直接讀進共享記憶體
+  share_frame_(snapshot->tick_);
+
   // Show up
+  PROFILE_BEGIN(PHASE_PRESENT);
   SDL_RenderPresent(renderer_);
+  PROFILE_END(PHASE_PRESENT, frames_);
+
+  PROFILE_END(PHASE_FRAME, frames_);
+
+#ifdef UXI_PROFILE
+  frames_ += 1;
+#endif
+
+  // 第一個畫面: 回報啟動花了多少時間
+  if (started_ != 0) {
+    printf("Startup: first frame after %.1f ms "
+           "(images %.1f ms, %d from pack, %d threads)\n",
+           (double)(SDL_GetPerformanceCounter() - started_) * 1000.0 /
+               (double)SDL_GetPerformanceFrequency(),
+           decode_ms_, SDL_AtomicGet(&packed_), job_system.workers());
+
+    started_ = 0;
+  }  // fi
 }  // update_()
 
 /**
- *  Assign one vector's content to another.
+ *  Request the sprites of the Skin object.  They are only requested;
+ *  load_images_() decodes them.
  *
+ *  @param Skin * the skin.
+ *  @return none.
  *  @since  0.1.0
  **/
-void vector_assign_(SDL_Point *p, SDL_Point *q) {
-  q->x = p->x;
-  q->y = p->y;
-}  // vector_assign_()
+void init_skin_(Skin *skin) {
+  char *meteor_names[] = {
+      "img/meteor_tiny1.png",  "img/meteor_tiny2.png", "img/meteor_small1.png",
+      "img/meteor_small2.png", "img/meteor_med1.png",  "img/meteor_med3.png",
+      "img/meteor_big1.png",   "img/meteor_big2.png",  "img/meteor_big3.png",
+      "img/meteor_big4.png",
+  };
 
-/**
- *  Negation operation on vector, i.e. v = -v;
- *
- *  @since  0.1.0
- **/
-void vector_neg_(SDL_Point *p) {
-  p->x = 0 - p->x;
-  p->y = 0 - p->y;
-}  // vector_neg_()
+  char file_png[32];
 
-/**
- *  Caculate and return vectors' dot product.
- *
- *  @since  0.1.0
- **/
-int vector_dot_(SDL_Point *p, SDL_Point *q) {
-  return ((p->x * q->x) + (p->y * q->y));
-}  // vector_dot_()
+  request_image_("img/darkPurple.png", &skin->background_);
+
+  skin->meteor_counts_ = (sizeof(meteor_names) / sizeof(char *));
+
+  // 依序要求 meteor 圖檔
+  for (int i = 0; i < skin->meteor_counts_; ++i) {
+    request_image_(meteor_names[i], &skin->meteors_[i]);
+  }  // od
+
+  request_image_("img/ship.png", &skin->ship_);
+
+  // 設定 Wings 的碎片圖檔
+  for (int i = 0; i < 3; ++i) {
+    sprintf(file_png, "img/damage%02d.png", i);
+    request_image_(file_png, &skin->damages_[i]);
+  }  // od
+
+  // 設定 Wings 的噴燄圖檔
+  for (int i = 0; i < 8; ++i) {
+    sprintf(file_png, "img/fire%02d.png", i);
+    request_image_(file_png, &skin->fire_[i]);
+  }  // od
+
+  // 設定 Wings 的雷射圖檔
+  for (int i = 1; i <= LASER_FRAMES; ++i) {
+    sprintf(file_png, "img/laserBlue%02d.png", i);
+    request_image_(file_png, &skin->lasers_[(i - 1)]);
+  }  // od
+}  // init_skin_()
 
 /**
- *  Do *Minkowski difference* on passed-in vectors.
+ *  Drop the skin's references to its sprites; a sprite is freed with
+ *  the last reference to it.
  *
+ *  @param Skin * the skin.
+ *  @return none.
  *  @since  0.1.0
  **/
-void vector_minus_(SDL_Point *p, SDL_Point *q, SDL_Point *r) {
-  r->x = p->x - q->x;
-  r->y = p->y - q->y;
-}  // vector_minus_()
+void release_skin_(Skin *skin) {
+  release_sprites_(&skin->background_, 1);
+  release_sprites_(skin->meteors_, skin->meteor_counts_);
+  release_sprites_(&skin->ship_, 1);
+  release_sprites_(skin->damages_, 3);
+  release_sprites_(skin->fire_, 8);
+  release_sprites_(skin->lasers_, LASER_FRAMES);
+
+  skin->meteor_counts_ = 0;
+}  // release_skin_()
 
 /**
- *  Support function used in gjk-algorithm.
+ *  Release `count` sprite handles through the registry and clear
+ *  them.
  *
  *  @since  0.1.0
  **/
-void gjk_support_(SDL_Rect const *rect, SDL_Point const *vec,
-                  SDL_Point *point) {
-  point->x = rect->x;
-  point->y = rect->y;
-
-  if (vec->x >= 0) {
-    point->x += rect->w;
-  }  // fi
+void release_sprites_(Sprite **sprites, int count) {
+  extern SpriteRegistry sprite_registry;
 
-  if (vec->y >= 0) {
-    point->y += rect->h;
-  }  // fi
-}  // gjk_support_()
+  for (int i = 0; i < count; ++i) {
+    if (sprites[i] != (Sprite *)NULL) {
+      sprite_registry.release(&sprites_, sprites[i]);
+      sprites[i] = (Sprite *)NULL;
+    }  // fi
+  }    // od
+}  // release_sprites_()
 
 /**
- *  Try to find a triangle which contains the origin.
+ *  Make the world from the options and the loaded sprites.  The
+ *  world borrows the job system for its phases and reports its events
+ *  to the trace.
  *
+ *  @param uint64_t the seed.
+ *  @return none.
  *  @since  0.1.0
  **/
-bool gjk_simplex_(SDL_Point *tri, SDL_Point *d) {
-  bool contain_origin = false;
-
-  SDL_Point ao;
-  SDL_Point ab;
-  SDL_Point ac;
+void init_world_(uint64_t seed) {
+  extern JobSystem job_system;
+  extern Options options;
+  extern Simulator simulator;
+  extern Trace trace;
 
-  vector_assign_(&tri[2], &ao);
-  vector_neg_(&ao);
+  WorldConfig config;
+  WorldHooks hooks;
 
-  vector_minus_(&tri[1], &tri[2], &ab);
+  memset(&config, 0, sizeof(WorldConfig));
 
-  d->x = 0 - ab.y;
-  d->y = ab.x;
+  config.seed_ = seed;
 
-  if (vector_dot_(d, &tri[0]) > 0) {
-    vector_neg_(d);
+  // 場景大小: 視窗大小, headless 或播放時為指定的解析度
+  if (options.headless_ || (options.replay_ != (char const *)NULL)) {
+    config.width_ = options.width_;
+    config.height_ = options.height_;
   }  // fi
+  else {
+    SDL_GetWindowSize(window_, &config.width_, &config.height_);
+  }  // esle
 
-  if (vector_dot_(d, &ao) > 0) {
-    vector_assign_(&tri[2], &tri[1]);
-
-    return contain_origin;
-  }  // fi
+  config.meteors_ = options.meteors_;
+  config.lasers_ = options.lasers_;
+  config.fire_rate_ = options.fire_rate_;
+  config.stress_ = options.stress_;
 
-  vector_minus_(&tri[0], &tri[2], &ac);
+  config.kinds_ = skin_.meteor_counts_;
 
-  d->x = 0 - ac.y;
-  d->y = ac.x;
+  for (int i = 0; i < skin_.meteor_counts_; ++i) {
+    shape_(skin_.meteors_[i], &config.meteor_shapes_[i]);
+  }  // od
 
-  if (vector_dot_(d, &tri[1]) > 0) {
-    vector_neg_(d);
-  }  // fi
+  shape_(skin_.ship_, &config.ship_);
 
-  if (vector_dot_(d, &ao) > 0) {
-    vector_assign_(&tri[2], &tri[0]);
+  // laser 的 box_ 以第一張雷射圖的大小設定, 遮罩也用它的
+  shape_(skin_.lasers_[0], &config.laser_);
 
-    return contain_origin;
-  }  // fi
+  hooks.parallel_for = job_system.parallel_for;
+  hooks.workers = job_system.workers();
+  hooks.event = trace.instant;
+#ifdef UXI_TRACE
+  hooks.phase = world_phase_;
+#endif
 
-  contain_origin = true;
+  simulator.init(&world_, &config, &hooks);
+}  // init_world_()
 
-  return contain_origin;
-}  // gjk_simplex_()
+/**
+ *  The Shape of a sprite: its size and its mask.
+ *
+ *  @since  0.1.0
+ **/
+void shape_(Sprite const *sprite, Shape *shape) {
+  shape->w_ = sprite->rect_.w;
+  shape->h_ = sprite->rect_.h;
+  shape->mask_ = &sprite->mask_;
+}  // shape_()
 
+#ifdef UXI_TRACE
 /**
- *  The GJK collision-detection algorithm.
+ *  WorldHooks::phase: mark and time the phases of a tick like the
+ *  game's own (PROFILE_BEGIN() and PROFILE_END()).  Called on the
+ *  simulation thread only; not installed without UXI_TRACE.
  *
  *  @since  0.1.0
  **/
-bool gjk_collides_(SDL_Rect const *rect_a, SDL_Rect const *rect_b) {
-  bool collided = false;
+void world_phase_(SimPhase phase, bool begin, uint32_t tick) {
+  extern Trace trace;
 
-  SDL_Point p;
-  SDL_Point q;
-  SDL_Point d = {1, 0};
-  SDL_Point a[3];
+  Phase timed = (Phase)(PHASE_UPDATE_LASERS + phase);
 
-  gjk_support_(rect_a, &d, &p);
+  (void)tick;
 
-  d.x = -1;
-  gjk_support_(rect_b, &d, &q);
+  if (begin) {
+#ifdef UXI_PROFILE
+    phase_at_[phase] = SDL_GetPerformanceCounter();
+#endif
+    trace.begin(profiler.name(timed));
+  }  // fi
+  else {
+    trace.end(profiler.name(timed));
+#ifdef UXI_PROFILE
+    profiler.record(timed, tick, phase_at_[phase]);
+#endif
+  }  // esle
+}  // world_phase_()
+#endif
 
-  vector_minus_(&p, &q, &a[0]);
+/**
+ *  Game initializer.  Initialize the gaming environment.
+ *
+ *  @param none.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void game_init_(void) {
+  extern JobSystem job_system;
+  extern SpriteRegistry sprite_registry;
+  extern Options options;
+  extern ReplayFile replay_file;
+  extern ShmExport shm_export;
+  extern SnapshotExchange snapshot_exchange;
+  extern Trace trace;
+
+  // 沒有指定 seed 時以時間為 seed
+  uint64_t seed = options.seeded_ ? options.seed_ : (uint64_t)time(NULL);
+
+  // 播放錄好的 session: seed 與場景大小都以檔案為準
+  if (options.replay_ != (char const *)NULL) {
+    if (!replay_file.open(&playback_, options.replay_)) {
+      printf("Replay Error: cannot read %s\n", options.replay_);
+      exit(-1);
+    }  // fi
 
-  vector_assign_(&a[0], &d);
-  gjk_support_(rect_b, &d, &q);
+    seed = playback_.seed_;
+    options.width_ = playback_.width_;
+    options.height_ = playback_.height_;
+    options.meteors_ = playback_.meteors_;
+    options.lasers_ = playback_.lasers_;
+    options.fire_rate_ = playback_.fire_rate_;
+    options.stress_ = playback_.stress_;
+  }  // fi
 
-  vector_neg_(&d);
-  gjk_support_(rect_a, &d, &p);
+  started_ = SDL_GetPerformanceCounter();
 
-  vector_minus_(&p, &q, &a[1]);
+  // 記錄整個 session 的事件, 結束時寫出
+  if (options.trace_ != (char const *)NULL) {
+    if (!trace.start(options.trace_)) {
+      printf("Trace Error: cannot write %s\n", options.trace_);
+      exit(-1);
+    }  // fi
 
-  if (vector_dot_(&d, &a[1]) <= 0) {
-    return collided;
+    trace.thread("main");
   }  // fi
 
-  vector_assign_(&a[1], &d);
-  vector_neg_(&d);
+  init_sdl_();
 
-  while (true) {
-    gjk_support_(rect_a, &d, &p);
-    vector_neg_(&d);
-    gjk_support_(rect_b, &d, &q);
-    vector_neg_(&d);
+  // 平行解碼圖檔, 更新與碰撞偵測都用得到的 workers
+  job_system.init(options.threads_);
 
-    vector_minus_(&p, &q, &a[2]);
+  sprite_registry.init(&sprites_, LOAD_CAPACITY);
 
-    if (vector_dot_(&d, &a[2]) <= 0) {
-      return collided;
-    }  // fi
+  // 背景, 隕石與戰機的圖檔
+  init_skin_(&skin_);
 
-    if (gjk_simplex_(a, &d)) {
-      collided = true;
+  // 一次平行解碼所有要求的圖檔
+  load_images_();
 
-      break;
-    };
-  }  // od
+  // 以圖檔的大小與遮罩建立模擬的世界
+  init_world_(seed);
 
-  return collided;
-}  // gjk_collides_()
+  if (options.stress_ || (options.meteors_ > 0) || (options.lasers_ > 0) ||
+      (options.fire_rate_ > 0)) {
+    printf("Stress: %d meteors, %d lasers at most",
+           world_.scene_.meteors_.count_, world_.scene_.lasers_.capacity_);
 
-void collide_lasers_(void) {
-  Scene *scene = (Scene *)NULL;
-  Meteor *meteors = (Meteor *)NULL;
-  Laser *laser = (Laser *)NULL;
+    if (options.fire_rate_ > 0) {
+      printf(", %d lasers/s", options.fire_rate_);
+    }  // fi
 
-  scene = game.scene;
+    printf("%s\n", options.stress_ ? ", scripted ship" : "");
+  }  // fi
 
-  for (int i = 0; i < scene->obj_counts_; ++i) {
-    meteors = scene->meteors_;
-    if (!meteors[i].visible_) {
-      continue;
+  if (options.record_ != (char const *)NULL) {
+    recording_.seed_ = seed;
+    recording_.width_ = world_.scene_.box_.w;
+    recording_.height_ = world_.scene_.box_.h;
+    recording_.meteors_ = options.meteors_;
+    recording_.lasers_ = options.lasers_;
+    recording_.fire_rate_ = options.fire_rate_;
+    recording_.stress_ = options.stress_;
+
+    if (!replay_file.create(&recording_, options.record_)) {
+      printf("Replay Error: cannot create %s\n", options.record_);
+      exit(-1);
     }  // fi
+  }    // fi
 
-    laser = game.scene->lasers_;
+  // 所有圖檔都已放入 atlas, 上傳成 texture
+  bake_atlas_();
 
-    while (laser != (Laser *)NULL) {
-      if (laser->body_enable && gjk_collides_(&laser->box_, &meteors[i].box_)) {
-        laser->exploding = true;
-        laser->velocity_ = 0;
-        laser->body_enable = false;
+  if (renderer_ != (SDL_Renderer *)NULL) {
+    int page_kib = ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE * 4 / 1024;
 
-        laser = laser->next_;
+    printf("Textures: %d sprites, %zu KiB used of %d atlas pages (%d KiB)\n",
+           sprites_.count_, sprite_registry.texture_bytes(&sprites_) / 1024,
+           atlas_pages_, atlas_pages_ * page_kib);
+  }  // fi
 
-        meteors[i].visible_ = false;
-      }  // fi
-      else {
-        laser = laser->next_;
-      }  // esle
-    }    // od
-  }
-}
+  // 模擬與繪圖執行緒交換資料用
+  snapshot_exchange.init(&snapshots_, world_.scene_.meteors_.count_,
+                         world_.scene_.lasers_.capacity_);
 
-/**
- *  Check if wings has been hit by some meteors.
- *
- *  @since  0.1.0
- **/
-void collide_wings_(void) {
-  Meteor *meteors = (Meteor *)NULL;
-  Scene *scene = (Scene *)NULL;
-  Wings *wings = (Wings *)NULL;
-  SDL_Rect hitbox;
+  input_lock_ = SDL_CreateMutex();
 
-  scene = game.scene;
-  wings = game.wings;
+  if (input_lock_ == (SDL_mutex *)NULL) {
+    printf("SDL Error: %s\n", SDL_GetError());
+    exit(-1);
+  }  // fi
 
-  for (int i = 0; i < scene->obj_counts_; ++i) {
-    meteors = scene->meteors_;
+  // 每個 tick 的狀態 (與畫面) 匯出給外部的工具
+  if (options.share_ != (char const *)NULL) {
+    int frame_w = 0;
+    int frame_h = 0;
 
-    if (!meteors[i].visible_) {
-      continue;
+    if (options.share_frames_ && (renderer_ != (SDL_Renderer *)NULL)) {
+      SDL_GetRendererOutputSize(renderer_, &frame_w, &frame_h);
     }  // fi
 
-    hitbox.x = wings->position_.x + wings->hitbox_[0].x;
-    hitbox.y = wings->position_.y + wings->hitbox_[0].y;
-    hitbox.w = wings->hitbox_[0].w;
-    hitbox.h = wings->hitbox_[0].h;
-
-    if (gjk_collides_(&hitbox, &meteors[i].box_)) {
-      meteors[i].visible_ = false;
-      wings->health -= 30;
-
-      if (wings->health <= 0) {
-        wings->alive = false;
-        if (wings->num_life > 0) {
-          wings->alive = true;
-          wings->health = 100;
-          int width;
-          int height;
-          SDL_GetWindowSize(window_, &width, &height);
-          wings->position_.x = ((width - wings->sprite_->rect_.w) / 2);
-          wings->position_.y = ((height / 2) + wings->sprite_->rect_.h);
-          wings->num_life -= 1;
-        }
-        break;
-      }
-
-      continue;
+    if (!shm_export.create(&shared_, options.share_,
+                           world_.scene_.meteors_.count_ +
+                               world_.scene_.lasers_.capacity_,
+                           frame_w, frame_h)) {
+      printf("Share Error: cannot create %s\n", shared_.name_);
+      exit(-1);
     }  // fi
 
-    hitbox.x = wings->position_.x + wings->hitbox_[1].x;
-    hitbox.y = wings->position_.y + wings->hitbox_[1].y;
-    hitbox.w = wings->hitbox_[1].w;
-    hitbox.h = wings->hitbox_[1].h;
-
-    if (gjk_collides_(&hitbox, &meteors[i].box_)) {
-      meteors[i].visible_ = false;
-      wings->health -= 30;
-      if (wings->health <= 0) {
-        wings->alive = false;
-        if (wings->num_life > 0) {
-          wings->alive = true;
-          wings->health = 100;
-          int width;
-          int height;
-          SDL_GetWindowSize(window_, &width, &height);
-          wings->position_.x = ((width - wings->sprite_->rect_.w) / 2);
-          wings->position_.y = ((height / 2) + wings->sprite_->rect_.h);
-          wings->num_life -= 1;
-        }
-        break;
-      }
-
-      continue;
-    }  // fi
-  }    // od
-}  // collide_wings_()
+    printf("Share: %s, %s\n", shared_.name_,
+           (frame_w > 0) ? "state and frames" : "state");
+  }  // fi
+}  // game_init_()
 
 /**
- *  Initialize a Laser object.
+ *  Ends the game.
  *
- *  @param Scene * the pointer to the Scene object to which these
- *         meteor belong.
+ *  @param none.
  *  @return none.
  *  @since  0.1.0
  **/
-void init_laser_(Scene *scene) {
-  Laser *laser;
-  Wings *wings;
+void game_over_(void) {
+  extern AtlasPacker atlas_packer;
+  extern JobSystem job_system;
+  extern ReplayFile replay_file;
+  extern ShmExport shm_export;
+  extern Simulator simulator;
+  extern SnapshotExchange snapshot_exchange;
+  extern SpriteBatcher sprite_batcher;
+  extern SpriteRegistry sprite_registry;
+  extern Trace trace;
+
+  // 其他執行緒都已停下, 寫出 trace (sprite 名稱尚未釋放)
+  trace.stop();
+
+#ifdef UXI_PROFILE
+  profiler.report();
+
+  if (!profiler.dump(PROFILE_CSV)) {
+    printf("Profile Error: cannot write %s\n", PROFILE_CSV);
+  }  // fi
+#endif
 
-  laser = (Laser *)malloc(sizeof(Laser));
+  snapshot_exchange.release(&snapshots_);
+  SDL_DestroyMutex(input_lock_);
 
-  laser->next_ = scene->lasers_;
-  scene->lasers_ = laser;
+  shm_export.close(&shared_);
 
-  wings = game.wings;
-  laser->sprite_ = wings->laser_sprites_[0];
-  laser->idx = 0;
+  replay_file.close(&recording_);
+  replay_file.close(&playback_);
 
-  // 設定雷射的位置在飛機的位置
-  laser->box_.x = wings->position_.x +
-                  ((wings->sprite_->rect_.w - laser->sprite_->rect_.w) / 2);
-  laser->box_.y = wings->position_.y - laser->sprite_->rect_.h;
-  laser->box_.w = laser->sprite_->rect_.w;
-  laser->box_.h = laser->sprite_->rect_.h;
+  simulator.release(&world_);
+  job_system.release();
 
-  laser->velocity_ = 5;
-  laser->visible_ = true;
-  laser->body_enable = true;
-  laser->exploding = false;
-  laser->exploding_idx = 7;
-}  // init_laser_()
+  // 放掉 skin 持有的 sprite, 最後一個參照會釋放它; 再釋放 registry
+  release_skin_(&skin_);
 
-/**
- *  Remove and relase laser object.
- *
- *  @since  0.1.0
- **/
-void laser_destroy_(Laser *laser) {
-  Laser *laser_c;
-  Scene *scene;
+  if (sprites_.count_ != 0) {
+    printf("Sprite Error: %d sprites still referenced\n", sprites_.count_);
+  }  // fi
+
+  sprite_registry.clear(&sprites_);
 
-  scene = game.scene;
+  for (int i = 0; i < atlas_pages_; ++i) {
+    atlas_packer.close(&atlas_[i]);
+  }  // od
+
+  atlas_pages_ = 0;
 
-  laser_c = scene->lasers_;
+  sprite_batcher.release(&batch_);
 
-  if (laser_c == laser) {
-    scene->lasers_ = laser_c->next_;
+  if (renderer_ != (SDL_Renderer *)NULL) {
+    SDL_DestroyRenderer(renderer_);
   }  // fi
-  else {
-    while (laser_c->next_ != laser) {
-      laser_c = laser_c->next_;
-    }  // od
 
-    laser_c->next_ = laser->next_;
-  }  // esle
+  if (window_ != (SDL_Window *)NULL) {
+    SDL_DestroyWindow(window_);
+  }  // fi
 
-  free(laser);
-}  // laser_destroy_()
+  if (target_ != (SDL_Surface *)NULL) {
+    SDL_FreeSurface(target_);
+  }  // fi
+
+  IMG_Quit();
+  SDL_Quit();
+}  // game_over_()
 
 /**
- *  Initialize the array of meteors.
+ *  Starts the game.
  *
- *  @param Scene * the pointer to the Scene object to which these
- *         meteor belong.
+ *  @param none.
  *  @return none.
  *  @since  0.1.0
  **/
-void init_meteors_(Scene *scene) {
-  int rows = 0;
-  int cols = 0;
-
-  Meteor *meteors;
-
-  // 將畫面劃分成大小為 256 * 192 的格子
-  // 每個格子有一個隕石
-  cols = scene->box_.w / 256;
-  rows = scene->box_.h / 192;
+void game_start_(void) { game_loop_(); }  // game_start_()
 
-  scene->obj_counts_ = rows * cols;
+#define MAX_FRAME_TIME 250  // 單一畫面最多補上的模擬時間 (ms)
 
-  meteors = (Meteor *)malloc(sizeof(Meteor) * scene->obj_counts_);
+/**
+ *  Advance the world by one fixed tick, timed as PHASE_TICK; the
+ *  world reports its own phases through world_phase_().
+ *
+ *  @param Input const * the player's input for this tick.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void step_(Input const *input) {
+  extern Simulator simulator;
 
-  for (int i = 0; i < scene->obj_counts_; ++i) {
-    extern Dice dice;
+  PROFILE_BEGIN(PHASE_TICK);
+  simulator.step(&world_, input);
+  PROFILE_END(PHASE_TICK, world_.tick_ - 1);
+}  // step_()
 
-    int tmp = 0;
+/**
+ *  Capture the world into a snapshot for the renderer.  Only the
+ *  visible meteors and lasers are recorded.
+ *
+ *  @param Snapshot * the slot to fill.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void capture_(Snapshot *snapshot) {
+  extern LaserAllocator laser_allocator;
+
+  Wings const *wings = &world_.wings_;
+  MeteorStore const *meteors = &world_.scene_.meteors_;
+  LaserPool const *pool = &world_.scene_.lasers_;
+  Laser const *laser = (Laser const *)NULL;
+  Pose *pose = (Pose *)NULL;
+
+  int count = 0;
+
+  snapshot->tick_ = world_.tick_;
+  snapshot->stamp_ = SDL_GetPerformanceCounter();
+  snapshot->alive_ = wings->alive;
+  snapshot->health_ = wings->health;
+  snapshot->wings_.x = wings->position_.x;
+  snapshot->wings_.y = wings->position_.y;
+  snapshot->wings_last_.x = wings->last_position_.x;
+  snapshot->wings_last_.y = wings->last_position_.y;
+
+  for (int i = 0; i < meteors->count_; ++i) {
+    if (meteors->flags_[i] & METEOR_VISIBLE) {
+      pose = &snapshot->meteors_[count++];
+
+      pose->box_.x = meteors->x_[i];
+      pose->box_.y = meteors->y_[i];
+      pose->box_.w = meteors->w_[i];
+      pose->box_.h = meteors->h_[i];
+      pose->dx_ = meteors->vx_[i];
+      pose->dy_ = meteors->vy_[i];
+      pose->sprite_ = skin_.meteors_[meteors->sprite_[i]];
+    }  // fi
+  }    // od
 
-    tmp = dice.roll(scene->sprite_counts_);
+  snapshot->meteor_count_ = count;
 
-    meteors[i].sprite_ = scene->meteor_sprites_[tmp];
+  count = 0;
 
-    meteors[i].velocity_ = dice.roll(5) + 1;
-    meteors[i].velocitx_ = dice.roll(3) + 1;
-    if (dice.roll(2) == 0) {
-      meteors[i].velocitx_ = -meteors[i].velocitx_;
-    }
+  for (int i = 0; i < pool->count_; ++i) {
+    laser = laser_allocator.at(pool, i);
 
-    // 設定隕石的位置
-    meteors[i].box_.x = dice.roll(128) + (i % cols) * 256;
-    meteors[i].box_.y = dice.roll(96) + (i / cols) * 192;
-    meteors[i].box_.w = meteors[i].sprite_->rect_.w;
-    meteors[i].box_.h = meteors[i].sprite_->rect_.h;
+    if (laser->visible_) {
+      pose = &snapshot->lasers_[count++];
 
-    if ((dice.roll(100) % 2) == 1) {
-      meteors[i].visible_ = true;
+      sdl_rect_(&laser->box_, &pose->box_);
+      pose->dx_ = 0;
+      pose->dy_ = -laser->velocity_;
+      pose->sprite_ = skin_.lasers_[laser->frame_];
     }  // fi
-    else {
-      meteors[i].visible_ = false;
-    }  // esle
-  }    // od;
+  }    // od
 
-  scene->meteors_ = meteors;
-}  // init_meteors_()
+  snapshot->laser_count_ = count;
+}  // capture_()
 
 /**
- *  Initialize the array of meteor sprites.
+ *  Read the frame just rendered into the next shared frame slot, with
+ *  --share-frames; the pixels go from the renderer straight into the
+ *  shared memory.  Called before the frame is presented.
  *
- *  @param Scene * the pointer to the Scene object to which these
- *         meteor sprites belong.
+ *  @param Uint32 the tick the frame shows.
  *  @return none.
  *  @since  0.1.0
  **/
-void init_meteor_sprites_(Scene *scene) {
-  char *sprite_names[] = {
-      "img/meteor_tiny1.png",  "img/meteor_tiny2.png", "img/meteor_small1.png",
-      "img/meteor_small2.png", "img/meteor_med1.png",  "img/meteor_med3.png",
-      "img/meteor_big1.png",   "img/meteor_big2.png",  "img/meteor_big3.png",
-      "img/meteor_big4.png",
-  };
+void share_frame_(Uint32 tick) {
+  extern ShmExport shm_export;
 
-  Sprite **sprites = (Sprite **)NULL;
+  SDL_Rect all = {0, 0, 0, 0};
+  void *pixels = (void *)NULL;
+  int pitch = 0;
 
-  scene->sprite_counts_ = (sizeof(sprite_names) / sizeof(char *));
+  if (shared_.header_ == (ShmHeader *)NULL) {
+    return;
+  }  // fi
 
-  sprites = (Sprite **)malloc(sizeof(Sprite *) * scene->sprite_counts_);
+  // 只讀 slot 的大小, 視窗大小改變時也不會寫出界
+  pixels = shm_export.frame_begin(&shared_, &all.w, &all.h, &pitch);
 
-  // 依序載入 meteor 圖檔
-  for (int i = 0; i < scene->sprite_counts_; ++i) {
-    sprites[i] = load_image_(sprite_names[i]);
-  }  // od
+  if (pixels == (void *)NULL) {
+    return;
+  }  // fi
 
-  scene->meteor_sprites_ = sprites;
-}  // init_meteor_sprites_()
+  SDL_RenderReadPixels(renderer_, &all, SDL_PIXELFORMAT_ARGB8888, pixels,
+                       pitch);
+
+  shm_export.frame_end(&shared_, tick);
+}  // share_frame_()
 
 /**
- *  Initialize the Scene object.
+ *  The input for the next tick: the keyboard's, or the recorded one
+ *  while playing back.  Quitting from the keyboard always wins.
  *
- *  @param none.
- *  @return Scene * pointer to the initialzed Scene object.
+ *  @param Input * the input.
+ *  @param uint32_t * the recorded state hash, when playing back.
+ *  @return bool false when the playback has ended.
  *  @since  0.1.0
  **/
-Scene *init_scene_(void) {
-  int width = 0;
-  int height = 0;
-  Scene *scene = (Scene *)NULL;
+bool next_input_(Input *input, uint32_t *expected) {
+  extern Options options;
+  extern ReplayFile replay_file;
+  extern Simulator simulator;
 
-  scene = (Scene *)malloc(sizeof(Scene));
-  scene->sprite_ = load_image_("img/darkPurple.png");
+  SDL_LockMutex(input_lock_);
+  *input = input_;
+  SDL_UnlockMutex(input_lock_);
 
-  SDL_GetWindowSize(window_, &width, &height);
-
-  scene->box_.w = width;
-  scene->box_.h = height;
-
-  // 初始化隕石 (meteor) 的 sprite 物件
-  init_meteor_sprites_(scene);
+  if (input->quit_) {
+    return true;
+  }  // fi
 
-  // 初始化 meteors 物件
-  init_meteors_(scene);
+  if (playback_.file_ != (FILE *)NULL) {
+    return replay_file.read(&playback_, input, expected);
+  }  // fi
 
-  scene->lasers_ = (Laser *)NULL;
+  // stress 模式由腳本駕駛, 鍵盤只用來結束
+  if (options.stress_) {
+    simulator.pilot(&world_, input);
+  }  // fi
 
-  return scene;
-}  // init_scene_()
+  return true;
+}  // next_input_()
 
 /**
- *  Initialize the Wings object.
+ *  The simulation thread.  Steps the world in fixed TICK_INTERVAL
+ *  ticks, driven by an accumulator of real (performance counter)
+ *  time, and publishes a snapshot after each batch of ticks.
+ *  Headless or --fast runs step as fast as possible.
  *
- *  @param none.
- *  @return Wings * pointer to the initialzed Wings object.
+ *  Each tick's input is recorded, or taken from the replay, with the
+ *  hash of the resulting state; a replayed tick whose hash differs
+ *  from the recorded one is reported.
+ *
+ *  @param void * unused.
+ *  @return int always 0.
  *  @since  0.1.0
  **/
-Wings *init_wings_(void) {
-  char file_png[32];
+int simulate_(void *data) {
+  extern Options options;
+  extern ReplayFile replay_file;
+  extern ShmExport shm_export;
+  extern Simulator simulator;
+  extern SnapshotExchange snapshot_exchange;
+  extern Trace trace;
 
-  int width = 0;
-  int height = 0;
+  Wings const *wings = &world_.wings_;
 
-  Wings *wings = (Wings *)NULL;
+  Input input;
 
-  wings = (Wings *)malloc(sizeof(Wings));
-  wings->sprite_ = load_image_("img/ship.png");
+  bool running = true;
+  uint32_t expected = 0;
+  uint32_t diverged = 0;  // 第一個不一致的 tick, 0 為沒有
 
-  // 設定 Wings 的碎片圖檔
-  for (int i = 0; i < 3; ++i) {
-    sprintf(file_png, "img/damage%02d.png", i);
-    wings->damages_[i] = load_image_(file_png);
-  }  // od
+  Uint64 const frequency = SDL_GetPerformanceFrequency();
+  Uint64 const step = frequency * TICK_INTERVAL / 1000;
+  Uint64 const max_frame = frequency * MAX_FRAME_TIME / 1000;
+  Uint64 last = SDL_GetPerformanceCounter();
+  Uint64 const began = last;
+  Uint64 accumulator = 0;
 
-  // 設定 Wings 的噴燄圖檔
-  for (int i = 0; i < 8; ++i) {
-    sprintf(file_png, "img/fire%02d.png", i);
-    wings->fire_[i] = load_image_(file_png);
-  }  // od
+  (void)data;
 
-  // 設定 Wings 的雷射圖檔
-  for (int i = 1; i < 12; ++i) {
-    sprintf(file_png, "img/laserBlue%02d.png", i);
-    wings->laser_sprites_[(i - 1)] = load_image_(file_png);
-  }  // od
+  trace.thread("simulate");
 
-  SDL_GetWindowSize(window_, &width, &height);
+  while (running) {
+    if (options.headless_ || options.fast_) {
+      // 不等真實時間, 連續模擬
+      accumulator = step;
+    }  // fi
+    else {
+      Uint64 now = SDL_GetPerformanceCounter();
 
-  // 設定 Wings 的 hitbox
-  wings->hitbox_[0].x = wings->sprite_->rect_.w / 2 - 10;
-  wings->hitbox_[0].y = 0;
-  wings->hitbox_[0].w = 10;
-  wings->hitbox_[0].h = wings->sprite_->rect_.h;
+      // 太慢的畫面 (例如視窗被拖動) 只補上有限的模擬時間,
+      // 避免追趕不完 (spiral of death)
+      accumulator += ((now - last) < max_frame) ? (now - last) : max_frame;
+      last = now;
+    }  // esle
 
-  wings->hitbox_[1].x = 0;
-  wings->hitbox_[1].y = wings->sprite_->rect_.h / 2;
-  wings->hitbox_[1].w = wings->sprite_->rect_.w;
-  wings->hitbox_[1].h = wings->sprite_->rect_.h / 2;
+    if (accumulator < step) {
+      // trace 中可看出 SDL_Delay 睡過頭的時間
+      trace.begin("SDL_Delay");
+      SDL_Delay((Uint32)((step - accumulator) * 1000 / frequency));
+      trace.end("SDL_Delay");
 
-  // 將 Wings 移至畫面中間
-  wings->position_.x = ((width - wings->sprite_->rect_.w) / 2);
-  wings->position_.y = ((height / 2) + wings->sprite_->rect_.h);
+      continue;
+    }  // fi
 
-  wings->alive = true;
-  wings->health = 100;
-  wings->num_life = 3;
-  wings->shot_laser_next_time = SDL_GetTicks();
+    while (running && (accumulator >= step)) {
+      uint32_t hash = 0;
 
-  return wings;
-}  // init_wings_()
+      accumulator -= step;
 
-/**
- *  Game initializer.  Initialize the gaming environment.
- *
- *  @param none.
- *  @return none.
- *  @since  0.1.0
- **/
-void game_init_(void) {
-  srand(time(NULL));
+      if (!next_input_(&input, &expected)) {
+        running = false;  // 播放完畢
 
-  init_sdl_();
+        break;
+      }  // fi
 
-  // 初始化背景
-  game.scene = init_scene_();
+      if (input.quit_) {
+        if (recording_.file_ != (FILE *)NULL) {
+          replay_file.write(&recording_, &input, simulator.hash(&world_));
+        }  // fi
 
-  // 初始化戰機
-  game.wings = init_wings_();
-}  // game_init_()
+        running = false;
 
-/**
- *  Ends the game.
- *
- *  @param none.
- *  @return none.
- *  @since  0.1.0
- **/
-void game_over_(void) {
-  Wings *wings = (Wings *)game.wings;
-  Scene *scene = (Scene *)game.scene;
+        break;
+      }  // fi
 
-  for (int i = 0; i < 11; ++i) {
-    SDL_DestroyTexture(wings->laser_sprites_[i]->texture_);
-    free(wings->laser_sprites_[i]);
-  }  // od
+      step_(&input);
 
-  for (int i = 0; i < 8; ++i) {
-    SDL_DestroyTexture(wings->fire_[i]->texture_);
-    free(wings->fire_[i]);
-  }  // od
+      if ((recording_.file_ != (FILE *)NULL) ||
+          (playback_.file_ != (FILE *)NULL)) {
+        hash = simulator.hash(&world_);
+      }  // fi
 
-  SDL_DestroyTexture(wings->sprite_->texture_);
-  free(wings->sprite_);
-  free(wings);
+      if (recording_.file_ != (FILE *)NULL) {
+        replay_file.write(&recording_, &input, hash);
+      }  // fi
 
-  free(scene->meteors_);
+      // 每個 tick 都發佈, 不等待讀取的一方
+      if (shared_.header_ != (ShmHeader *)NULL) {
+        shm_export.publish(&shared_, &world_);
+      }  // fi
+
+      if ((playback_.file_ != (FILE *)NULL) && (hash != expected) &&
+          (diverged == 0)) {
+        diverged = world_.tick_;
+        printf("Replay: state diverged at tick %u\n", diverged);
+      }  // fi
 
-  for (int i = 0; i < scene->sprite_counts_; ++i) {
-    Sprite **sprites = scene->meteor_sprites_;
+      // --frames N: 跑滿 N 個 tick 後結束
+      if ((options.frames_ > 0) &&
+          (world_.tick_ >= (uint32_t)options.frames_)) {
+        running = false;
+      }  // fi
 
-    SDL_DestroyTexture(sprites[i]->texture_);
-    free(sprites[i]);
+      if (!wings->alive) {
+        running = false;
+      }  // fi
+    }    // od
+
+    capture_(snapshot_exchange.back(&snapshots_));
+    snapshot_exchange.publish(&snapshots_);
   }  // od
 
-  free(scene->meteor_sprites_);
+  if (playback_.file_ != (FILE *)NULL) {
+    if (diverged == 0) {
+      printf("Replay: %u ticks, every state matches\n", world_.tick_);
+    }  // fi
+    else {
+      printf("Replay: %u ticks, diverged at tick %u\n", world_.tick_,
+             diverged);
+    }  // esle
+  }    // fi
 
-  SDL_DestroyTexture(scene->sprite_->texture_);
-  free(scene->sprite_);
-  free(scene);
+  // make bench 由這一行取得每個 tick 的時間
+  printf("Session: %u ticks in %.1f ms\n", world_.tick_,
+         (double)(SDL_GetPerformanceCounter() - began) * 1000.0 /
+             (double)frequency);
 
-  SDL_DestroyRenderer(renderer_);
-  SDL_DestroyWindow(window_);
+  SDL_AtomicSet(&done_, 1);
 
-  IMG_Quit();
-  SDL_Quit();
-}  // game_over_()
+  return 0;
+}  // simulate_()
 
 /**
- *  Starts the game.
+ *  The main-loop of the game.  Game over when the loop ends.
+ *
+ *  The simulation runs on its own thread (simulate_()); this thread
+ *  handles the events and renders the latest published snapshot,
+ *  interpolated by the time since it was published, so the two
+ *  stages overlap.
  *
  *  @param none.
  *  @return none.
  *  @since  0.1.0
  **/
-void game_start_(void) { game_loop_(); }  // game_start_()
+void game_loop_(void) {
+  extern Options options;
+  extern ShmExport shm_export;
+  extern SnapshotExchange snapshot_exchange;
+  extern Trace trace;
 
-#define TICK_INTERVAL 40
+  Snapshot const *snapshot = (Snapshot const *)NULL;
+  SDL_Thread *thread = (SDL_Thread *)NULL;
 
-static Uint32 next_time;
+  Input input = {false, false, false, false, false, false};
 
-Uint32 time_left(void) {
-  Uint32 now;
+  Uint64 const step = SDL_GetPerformanceFrequency() * TICK_INTERVAL / 1000;
 
-  now = SDL_GetTicks();
-  if (next_time <= now)
-    return 0;
-  else
-    return next_time - now;
-}
+  // 先發佈初始狀態, 模擬開始前也有畫面可畫
+  capture_(snapshot_exchange.back(&snapshots_));
+  snapshot_exchange.publish(&snapshots_);
 
-/**
- *  The main-loop of the game.  Game over when the loop ends.
- *
- *  @param none.
- *  @return none.
- *  @since  0.1.0
- **/
-void game_loop_(void) {
-  Scene *scene = game.scene;
-  Wings *wings = game.wings;
+  if (shared_.header_ != (ShmHeader *)NULL) {
+    shm_export.publish(&shared_, &world_);
+  }  // fi
 
-  next_time = SDL_GetTicks() + TICK_INTERVAL;
+  thread = SDL_CreateThread(simulate_, "simulate", (void *)NULL);
 
-  bool up = false;
-  bool down = false;
-  bool left = false;
-  bool right = false;
-  bool space = false;
+  if (thread == (SDL_Thread *)NULL) {
+    printf("SDL Error: %s\n", SDL_GetError());
+    exit(-1);
+  }  // fi
 
-  while (wings->alive)  // 程式主迴圈 (game loop)
+  while (!SDL_AtomicGet(&done_))  // 程式主迴圈 (game loop)
   {
     SDL_Event event;
+    float alpha = 1.0f;
 
     while (SDL_PollEvent(&event) != 0) {
       switch (event.type) {
         case SDL_QUIT:
-          wings->alive = false;
+          input.quit_ = true;
 
           break;
 
         case SDL_KEYUP:
           switch (event.key.keysym.sym) {
             case SDLK_UP:
-              up = false;
+              input.up_ = false;
 
               break;
 
             case SDLK_DOWN:
-              down = false;
+              input.down_ = false;
 
               break;
 
             case SDLK_LEFT:
-              left = false;
+              input.left_ = false;
 
               break;
 
             case SDLK_RIGHT:
-              right = false;
+              input.right_ = false;
 
               break;
 
             case SDLK_SPACE:
-              space = false;
+              input.fire_ = false;
 
               break;
 
@@ -1044,32 +1479,39 @@ void game_loop_(void) {
         case SDL_KEYDOWN:
           switch (event.key.keysym.sym) {
             case SDLK_q:
-              wings->alive = false;
+              input.quit_ = true;
 
               break;
 
+#ifdef UXI_PROFILE
+            case SDLK_F3:
+              profiler.toggle();
+
+              break;
+#endif
+
             case SDLK_UP:
-              up = true;
+              input.up_ = true;
 
               break;
 
             case SDLK_DOWN:
-              down = true;
+              input.down_ = true;
 
               break;
 
             case SDLK_LEFT:
-              left = true;
+              input.left_ = true;
 
               break;
 
             case SDLK_RIGHT:
-              right = true;
+              input.right_ = true;
 
               break;
 
             case SDLK_SPACE:
-              space = true;
+              input.fire_ = true;
 
               break;
 
@@ -1084,35 +1526,31 @@ void game_loop_(void) {
       }  // esac
     }    // od
 
-    if (up) {
-      wings->position_.y -= 10;
-    }
-    if (down) {
-      wings->position_.y += 10;
-    }
-    if (left) {
-      wings->position_.x -= 10;
-    }
-    if (right) {
-      wings->position_.x += 10;
-    }
-    if (space) {
-      if (wings->shot_laser_next_time <= SDL_GetTicks()) {
-        init_laser_(scene);
-        wings->shot_laser_next_time = SDL_GetTicks() + 400;
-      }
-    }
-    update_lasers_();   // 移動 lasers 的位置
-    update_meteors_();  // 捲動 meteors 的位置
-
-    collide_lasers_();
-    collide_wings_();
-
-    update_();  // 更新畫面
-
-    SDL_Delay(time_left());
-    next_time += TICK_INTERVAL;
+    SDL_LockMutex(input_lock_);
+    input_ = input;
+    SDL_UnlockMutex(input_lock_);
+
+    // headless=none: 不繪圖, 等模擬結束
+    if (renderer_ == (SDL_Renderer *)NULL) {
+      trace.begin("SDL_Delay");
+      SDL_Delay(1);
+      trace.end("SDL_Delay");
+
+      continue;
+    }  // fi
+
+    snapshot = snapshot_exchange.acquire(&snapshots_);
+
+    if (!options.headless_) {
+      Uint64 since = SDL_GetPerformanceCounter() - snapshot->stamp_;
+
+      alpha = (since < step) ? (float)since / (float)step : 1.0f;
+    }  // fi
+
+    update_(snapshot, alpha);  // 更新畫面
   }  // od
+
+  SDL_WaitThread(thread, (int *)NULL);
 }  // game_loop_()
 
 // game.c
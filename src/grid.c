@@ -0,0 +1,332 @@
+/**
+ *  @file       grid.c
+ *  @brief      Defines the uniform-grid broadphase.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The grid file.
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "grid.h"
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static void init_(Grid *, int, int, int, int);
+static void release_(Grid *);
+static void build_(Grid *, MeteorStore const *);
+static void span_(Grid const *, int, int, int, int, GridSpan *);
+static void swept_span_(Grid const *, MeteorStore const *, int, GridSpan *);
+static int gather_(Grid *, int, int, int, int, int32_t *);
+static int search_(Grid const *, GridMarks *, int, int, int, int, int32_t *);
+static void marks_init_(GridMarks *);
+static void marks_release_(GridMarks *);
+static int clamp_(int, int, int);
+static int compare_(void const *, void const *);
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global GridIndex object.
+ *
+ *  @since  0.1.0
+ **/
+GridIndex grid_index = {
+    init_,   release_, build_,      span_,
+    gather_, search_,  marks_init_, marks_release_,
+};  // grid_index
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Initialize a grid covering a (width, height) scene.
+ *
+ *  @param Grid * the grid to initialize.
+ *  @param int scene width.
+ *  @param int scene height.
+ *  @param int cell width.
+ *  @param int cell height.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void init_(Grid *grid, int width, int height, int cell_w, int cell_h) {
+  grid->cell_w_ = cell_w;
+  grid->cell_h_ = cell_h;
+
+  grid->cols_ = (width + cell_w - 1) / cell_w;
+  grid->rows_ = (height + cell_h - 1) / cell_h;
+
+  if (grid->cols_ < 1) grid->cols_ = 1;
+  if (grid->rows_ < 1) grid->rows_ = 1;
+
+  grid->start_ =
+      (int32_t *)calloc(grid->cols_ * grid->rows_ + 1, sizeof(int32_t));
+
+  grid->capacity_ = 0;
+  grid->items_ = (int32_t *)NULL;
+
+  grid->meteors_ = 0;
+  marks_init_(&grid->marks_);
+}  // init_()
+
+/**
+ *  Release the storage of a grid.
+ *
+ *  @since  0.1.0
+ **/
+void release_(Grid *grid) {
+  free(grid->start_);
+  free(grid->items_);
+  marks_release_(&grid->marks_);
+
+  grid->start_ = (int32_t *)NULL;
+  grid->items_ = (int32_t *)NULL;
+  grid->capacity_ = 0;
+  grid->meteors_ = 0;
+}  // release_()
+
+/**
+ *  Initialize an empty GridMarks; it grows on first use.
+ *
+ *  @since  0.1.0
+ **/
+void marks_init_(GridMarks *marks) {
+  marks->meteors_ = 0;
+  marks->epoch_ = 0;
+  marks->stamp_ = (uint32_t *)NULL;
+}  // marks_init_()
+
+/**
+ *  Release the storage of a GridMarks.
+ *
+ *  @since  0.1.0
+ **/
+void marks_release_(GridMarks *marks) {
+  free(marks->stamp_);
+
+  marks_init_(marks);
+}  // marks_release_()
+
+/**
+ *  Clamp v into [lo, hi].
+ *
+ *  @since  0.1.0
+ **/
+int clamp_(int v, int lo, int hi) {
+  return (v < lo) ? lo : ((v > hi) ? hi : v);
+}  // clamp_()
+
+/**
+ *  Compute the range of cells a box touches.  Boxes outside the
+ *  scene are clamped onto the border cells, which keeps overlapping
+ *  boxes sharing at least one cell.
+ *
+ *  @since  0.1.0
+ **/
+void span_(Grid const *grid, int x, int y, int w, int h, GridSpan *span) {
+  span->col0_ = clamp_(x / grid->cell_w_, 0, grid->cols_ - 1);
+  span->row0_ = clamp_(y / grid->cell_h_, 0, grid->rows_ - 1);
+  span->col1_ = clamp_((x + w) / grid->cell_w_, 0, grid->cols_ - 1);
+  span->row1_ = clamp_((y + h) / grid->cell_h_, 0, grid->rows_ - 1);
+}  // span_()
+
+/**
+ *  Compute the cells touched by the i-th meteor's swept box.
+ *
+ *  @since  0.1.0
+ **/
+void swept_span_(Grid const *grid, MeteorStore const *meteors, int i,
+                 GridSpan *span) {
+  int x = meteors->x_[i];
+  int y = meteors->y_[i];
+
+  // 起點 = 終點 - 速度
+  int x0 = (meteors->vx_[i] > 0) ? x - meteors->vx_[i] : x;
+  int y0 = (meteors->vy_[i] > 0) ? y - meteors->vy_[i] : y;
+  int vx = (meteors->vx_[i] > 0) ? meteors->vx_[i] : -meteors->vx_[i];
+  int vy = (meteors->vy_[i] > 0) ? meteors->vy_[i] : -meteors->vy_[i];
+
+  span_(grid, x0, y0, meteors->w_[i] + vx, meteors->h_[i] + vy, span);
+}  // swept_span_()
+
+/**
+ *  Rebuild the grid from the visible meteors with a counting sort:
+ *  count the meteors per cell, prefix-sum the counts into `start_`,
+ *  then scatter the meteor indices.  Items of a cell stay in
+ *  ascending meteor order.
+ *
+ *  @param Grid * the grid.
+ *  @param MeteorStore const * the meteors to index.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void build_(Grid *grid, MeteorStore const *meteors) {
+  int cells = grid->cols_ * grid->rows_;
+  int total = 0;
+
+  GridSpan span;
+
+  memset(grid->start_, 0, sizeof(int32_t) * (cells + 1));
+
+  grid->meteors_ = meteors->count_;
+
+  // 計算每個格子的隕石數量, 暫存在 start_[c + 1]
+  for (int i = 0; i < meteors->count_; ++i) {
+    if (!(meteors->flags_[i] & METEOR_VISIBLE)) {
+      continue;
+    }  // fi
+
+    swept_span_(grid, meteors, i, &span);
+
+    for (int r = span.row0_; r <= span.row1_; ++r) {
+      for (int c = span.col0_; c <= span.col1_; ++c) {
+        ++grid->start_[r * grid->cols_ + c + 1];
+      }  // od
+    }    // od
+  }      // od
+
+  for (int c = 0; c < cells; ++c) {
+    grid->start_[c + 1] += grid->start_[c];
+  }  // od
+
+  total = grid->start_[cells];
+
+  if (total > grid->capacity_) {
+    grid->capacity_ = total * 2;
+    grid->items_ =
+        (int32_t *)realloc(grid->items_, sizeof(int32_t) * grid->capacity_);
+  }  // fi
+
+  // 第二輪: start_[c] 當作寫入游標, 填完後 start_[c] 會等於原本的
+  // start_[c + 1], 所以最後再整體右移一格
+  for (int i = 0; i < meteors->count_; ++i) {
+    if (!(meteors->flags_[i] & METEOR_VISIBLE)) {
+      continue;
+    }  // fi
+
+    swept_span_(grid, meteors, i, &span);
+
+    for (int r = span.row0_; r <= span.row1_; ++r) {
+      for (int c = span.col0_; c <= span.col1_; ++c) {
+        grid->items_[grid->start_[r * grid->cols_ + c]++] = i;
+      }  // od
+    }    // od
+  }      // od
+
+  memmove(grid->start_ + 1, grid->start_, sizeof(int32_t) * cells);
+  grid->start_[0] = 0;
+}  // build_()
+
+/**
+ *  qsort() comparator for meteor indices.
+ *
+ *  @since  0.1.0
+ **/
+int compare_(void const *a, void const *b) {
+  int32_t p = *(int32_t const *)a;
+  int32_t q = *(int32_t const *)b;
+
+  return (p > q) - (p < q);
+}  // compare_()
+
+/**
+ *  Collect the meteors sharing a cell with the given box into `out`,
+ *  each once and in ascending order.  `out` must hold as many entries
+ *  as there are meteors.
+ *
+ *  @return int number of meteors collected.
+ *  @since  0.1.0
+ **/
+int gather_(Grid *grid, int x, int y, int w, int h, int32_t *out) {
+  return search_(grid, &grid->marks_, x, y, w, h, out);
+}  // gather_()
+
+/**
+ *  gather() with caller-owned marks.  The grid is only read, so
+ *  queries with distinct marks may run at the same time.
+ *
+ *  @param Grid const * the grid.
+ *  @param GridMarks * the scratch marks of this query.
+ *  @param int x of the box.
+ *  @param int y of the box.
+ *  @param int width of the box.
+ *  @param int height of the box.
+ *  @param int32_t * where to collect the meteor indices.
+ *  @return int number of meteors collected.
+ *  @since  0.1.0
+ **/
+int search_(Grid const *grid, GridMarks *marks, int x, int y, int w, int h,
+            int32_t *out) {
+  int count = 0;
+
+  GridSpan span;
+
+  if (marks->meteors_ < grid->meteors_) {
+    marks->meteors_ = grid->meteors_;
+    marks->stamp_ = (uint32_t *)realloc(marks->stamp_,
+                                        sizeof(uint32_t) * marks->meteors_);
+    memset(marks->stamp_, 0, sizeof(uint32_t) * marks->meteors_);
+    marks->epoch_ = 0;
+  }  // fi
+
+  // epoch 繞回 0 時重設所有 stamp
+  if (++marks->epoch_ == 0) {
+    memset(marks->stamp_, 0, sizeof(uint32_t) * marks->meteors_);
+    marks->epoch_ = 1;
+  }  // fi
+
+  span_(grid, x, y, w, h, &span);
+
+  for (int r = span.row0_; r <= span.row1_; ++r) {
+    for (int c = span.col0_; c <= span.col1_; ++c) {
+      int cell = r * grid->cols_ + c;
+
+      for (int k = grid->start_[cell]; k < grid->start_[cell + 1]; ++k) {
+        int i = grid->items_[k];
+
+        if (marks->stamp_[i] != marks->epoch_) {
+          marks->stamp_[i] = marks->epoch_;
+          out[count++] = i;
+        }  // fi
+      }    // od
+    }      // od
+  }        // od
+
+  if (count > 1) {
+    qsort(out, count, sizeof(int32_t), compare_);
+  }  // fi
+
+  return count;
+}  // search_()
+
+// grid.c
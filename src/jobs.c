@@ -0,0 +1,354 @@
+/**
+ *  @file       jobs.c
+ *  @brief      Defines the work-stealing job system.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The jobs file.
+ **/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "jobs.h"
+#include "trace.h"
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static void init_(int);
+static void release_(void);
+static int workers_(void);
+static void parallel_for_(int, int, JobRange, void *);
+
+static int worker_(void *);
+static bool next_(int, Job *);
+static bool pop_(JobDeque *, Job *);
+static bool steal_(JobDeque *, Job *);
+static void run_(Job const *, int);
+
+// 內部資料欄位 (private data) 宣告
+static JobDeque deques_[JOBS_MAX_WORKERS];  // deques_[0]: 呼叫端
+static SDL_Thread *threads_[JOBS_MAX_WORKERS];
+static int count_ = 1;  // worker 數, 含呼叫端
+
+static SDL_sem *wake_ = (SDL_sem *)NULL;
+static SDL_atomic_t pending_;  // 尚未完成的工作數
+static SDL_atomic_t quit_;
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global JobSystem object.  Until init() is called everything
+ *  runs on the calling thread.
+ *
+ *  @since  0.1.0
+ **/
+JobSystem job_system = {
+    init_, release_, workers_, parallel_for_,
+};  // job_system
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Start the job system with `workers` workers, the calling thread
+ *  included.  0 (or less) means one worker per CPU.
+ *
+ *  @param int number of workers.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void init_(int workers) {
+  if (workers <= 0) {
+    workers = SDL_GetCPUCount();
+  }  // fi
+
+  if (workers > JOBS_MAX_WORKERS) {
+    workers = JOBS_MAX_WORKERS;
+  }  // fi
+
+  count_ = (workers < 1) ? 1 : workers;
+
+  SDL_AtomicSet(&pending_, 0);
+  SDL_AtomicSet(&quit_, 0);
+
+  for (int i = 0; i < count_; ++i) {
+    deques_[i].lock_ = 0;
+    deques_[i].top_ = 0;
+    deques_[i].bottom_ = 0;
+  }  // od
+
+  if (count_ == 1) {
+    return;
+  }  // fi
+
+  wake_ = SDL_CreateSemaphore(0);
+
+  if (wake_ == (SDL_sem *)NULL) {
+    printf("SDL Error: %s\n", SDL_GetError());
+    exit(-1);
+  }  // fi
+
+  for (int i = 1; i < count_; ++i) {
+    threads_[i] = SDL_CreateThread(worker_, "jobs", (void *)(intptr_t)i);
+
+    if (threads_[i] == (SDL_Thread *)NULL) {
+      printf("SDL Error: %s\n", SDL_GetError());
+      exit(-1);
+    }  // fi
+  }    // od
+}  // init_()
+
+/**
+ *  Stop the worker threads.  The job system falls back to running
+ *  everything on the calling thread.
+ *
+ *  @since  0.1.0
+ **/
+void release_(void) {
+  if (count_ > 1) {
+    SDL_AtomicSet(&quit_, 1);
+
+    for (int i = 1; i < count_; ++i) {
+      SDL_SemPost(wake_);
+    }  // od
+
+    for (int i = 1; i < count_; ++i) {
+      SDL_WaitThread(threads_[i], (int *)NULL);
+    }  // od
+
+    SDL_DestroySemaphore(wake_);
+    wake_ = (SDL_sem *)NULL;
+  }  // fi
+
+  count_ = 1;
+}  // release_()
+
+/**
+ *  Number of workers, the calling thread included.
+ *
+ *  @since  0.1.0
+ **/
+int workers_(void) { return count_; }  // workers_()
+
+/**
+ *  Run body over [0, count) in chunks of (at least) `grain` indices
+ *  and return when all of them are done.  Consecutive chunks start on
+ *  the same worker; idle workers steal the rest.  Which worker runs
+ *  a chunk varies from run to run, so bodies must write disjoint
+ *  per-index (or per-chunk) results and leave merging to the caller.
+ *
+ *  Only one thread may call parallel_for() at a time, and bodies
+ *  must not call it again.
+ *
+ *  @param int number of indices.
+ *  @param int indices per chunk.
+ *  @param JobRange the body.
+ *  @param void * context passed to the body.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void parallel_for_(int count, int grain, JobRange body, void *context) {
+  int chunks = 0;
+
+  Job job;
+
+  if (count <= 0) {
+    return;
+  }  // fi
+
+  if (grain < 1) {
+    grain = 1;
+  }  // fi
+
+  // 每個 deque 最多放 JOBS_DEQUE_CAPACITY 個工作, 太多就加大 grain
+  if ((count + grain - 1) / grain > count_ * JOBS_DEQUE_CAPACITY) {
+    grain = (count + count_ * JOBS_DEQUE_CAPACITY - 1) /
+            (count_ * JOBS_DEQUE_CAPACITY);
+  }  // fi
+
+  chunks = (count + grain - 1) / grain;
+
+  if ((count_ == 1) || (chunks == 1)) {
+    body(context, 0, count, 0);
+
+    return;
+  }  // fi
+
+  SDL_AtomicSet(&pending_, chunks);
+
+  for (int w = 0; w < count_; ++w) {
+    JobDeque *deque = &deques_[w];
+
+    int first = chunks * w / count_;
+    int last = chunks * (w + 1) / count_;
+
+    SDL_AtomicLock(&deque->lock_);
+
+    deque->top_ = 0;
+    deque->bottom_ = 0;
+
+    // 倒著放, owner 從 bottom 取出時就是依序處理
+    for (int k = last - 1; k >= first; --k) {
+      Job *slot = &deque->jobs_[deque->bottom_++];
+
+      slot->body_ = body;
+      slot->context_ = context;
+      slot->begin_ = k * grain;
+      slot->end_ = (k * grain + grain < count) ? k * grain + grain : count;
+    }  // od
+
+    SDL_AtomicUnlock(&deque->lock_);
+  }  // od
+
+  for (int w = 1; w < count_; ++w) {
+    SDL_SemPost(wake_);
+  }  // od
+
+  // 呼叫端也是 worker, 做完自己的再去偷, 直到全部完成
+  while (SDL_AtomicGet(&pending_) > 0) {
+    if (next_(0, &job)) {
+      run_(&job, 0);
+    }  // fi
+  }    // od
+}  // parallel_for_()
+
+/**
+ *  Worker thread: sleep until parallel_for() posts work, then run
+ *  jobs until none is left anywhere.
+ *
+ *  @param void * the worker index.
+ *  @return int always 0.
+ *  @since  0.1.0
+ **/
+int worker_(void *data) {
+  extern Trace trace;
+
+  int self = (int)(intptr_t)data;
+  char name[16];
+
+  Job job;
+
+  snprintf(name, sizeof(name), "worker %d", self);
+  trace.thread(name);
+
+  while (true) {
+    SDL_SemWait(wake_);
+
+    if (SDL_AtomicGet(&quit_)) {
+      break;
+    }  // fi
+
+    while (next_(self, &job)) {
+      run_(&job, self);
+    }  // od
+  }    // od
+
+  return 0;
+}  // worker_()
+
+/**
+ *  Take the next job for worker `self`: its own newest job first,
+ *  otherwise the oldest job of another worker.
+ *
+ *  @since  0.1.0
+ **/
+bool next_(int self, Job *job) {
+  if (pop_(&deques_[self], job)) {
+    return true;
+  }  // fi
+
+  for (int v = 1; v < count_; ++v) {
+    if (steal_(&deques_[(self + v) % count_], job)) {
+      return true;
+    }  // fi
+  }    // od
+
+  return false;
+}  // next_()
+
+/**
+ *  Take a job from the bottom (owner's end) of a deque.
+ *
+ *  @since  0.1.0
+ **/
+bool pop_(JobDeque *deque, Job *job) {
+  bool found = false;
+
+  SDL_AtomicLock(&deque->lock_);
+
+  if (deque->bottom_ > deque->top_) {
+    *job = deque->jobs_[--deque->bottom_];
+    found = true;
+  }  // fi
+
+  SDL_AtomicUnlock(&deque->lock_);
+
+  return found;
+}  // pop_()
+
+/**
+ *  Take a job from the top (thieves' end) of a deque.
+ *
+ *  @since  0.1.0
+ **/
+bool steal_(JobDeque *deque, Job *job) {
+  bool found = false;
+
+  SDL_AtomicLock(&deque->lock_);
+
+  if (deque->bottom_ > deque->top_) {
+    *job = deque->jobs_[deque->top_++];
+    found = true;
+  }  // fi
+
+  SDL_AtomicUnlock(&deque->lock_);
+
+  return found;
+}  // steal_()
+
+/**
+ *  Run a job and count it done.
+ *
+ *  @since  0.1.0
+ **/
+void run_(Job const *job, int worker) {
+  extern Trace trace;
+
+  trace.begin("job");
+  job->body_(job->context_, job->begin_, job->end_, worker);
+  trace.end("job");
+
+  SDL_AtomicAdd(&pending_, -1);
+}  // run_()
+
+// jobs.c
@@ -0,0 +1,151 @@
+/**
+ *  @file       laser.c
+ *  @brief      Defines the laser pool.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The laser pool.  The only heap allocation is done once by init();
+ *  alloc() and destroy() are O(1) index swaps.
+ **/
+
+#include <stdlib.h>
+
+#include "laser.h"
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static void init_(LaserPool *, int);
+static void release_(LaserPool *);
+static void clear_(LaserPool *);
+static Laser *at_(LaserPool const *, int);
+static Laser *alloc_(LaserPool *);
+static void destroy_(LaserPool *, int);
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global LaserAllocator object.
+ *
+ *  @since  0.1.0
+ **/
+LaserAllocator laser_allocator = {
+    init_, release_, clear_, at_, alloc_, destroy_,
+};  // laser_allocator
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Allocate the storage of a LaserPool.  This is the only heap
+ *  allocation the pool ever does.
+ *
+ *  @param LaserPool * the pool to initialize.
+ *  @param int the maximum number of live lasers.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void init_(LaserPool *pool, int capacity) {
+  pool->capacity_ = capacity;
+
+  pool->slots_ = (Laser *)malloc(sizeof(Laser) * capacity);
+  pool->index_ = (int *)malloc(sizeof(int) * capacity);
+
+  clear_(pool);
+}  // init_()
+
+/**
+ *  Release the storage of a LaserPool.
+ *
+ *  @since  0.1.0
+ **/
+void release_(LaserPool *pool) {
+  free(pool->slots_);
+  free(pool->index_);
+
+  pool->slots_ = (Laser *)NULL;
+  pool->index_ = (int *)NULL;
+  pool->capacity_ = 0;
+  pool->count_ = 0;
+}  // release_()
+
+/**
+ *  Destroy every laser, leaving the pool as init() made it.
+ *
+ *  @since  0.1.0
+ **/
+void clear_(LaserPool *pool) {
+  pool->count_ = 0;
+
+  // 所有 slot 回到 free-index stack 上
+  for (int i = 0; i < pool->capacity_; ++i) {
+    pool->index_[i] = i;
+  }  // od
+}  // clear_()
+
+/**
+ *  Return the i-th live laser of the pool.
+ *
+ *  @since  0.1.0
+ **/
+Laser *at_(LaserPool const *pool, int i) {
+  return &pool->slots_[pool->index_[i]];
+}  // at_()
+
+/**
+ *  Pop a free slot and append it to the live lasers.
+ *
+ *  @return Laser * the new laser, NULL when the pool is full.
+ *  @since  0.1.0
+ **/
+Laser *alloc_(LaserPool *pool) {
+  if (pool->count_ == pool->capacity_) {
+    return (Laser *)NULL;
+  }  // fi
+
+  return &pool->slots_[pool->index_[pool->count_++]];
+}  // alloc_()
+
+/**
+ *  Remove the i-th live laser.  The last live laser takes its place
+ *  and the freed slot becomes the top of the free-index stack.
+ *
+ *  @since  0.1.0
+ **/
+void destroy_(LaserPool *pool, int i) {
+  int last = pool->count_ - 1;
+  int slot = pool->index_[i];
+
+  pool->index_[i] = pool->index_[last];
+  pool->index_[last] = slot;
+
+  pool->count_ = last;
+}  // destroy_()
+
+// laser.c
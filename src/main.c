@@ -38,12 +38,16 @@
 
 //#include "about.h"
 #include "game.h"
+#include "options.h"
 
 #include "main.h"
 
 int main(int argc, char *argv[]) {
   //    extern About about;
   extern Game game;
+  extern Options options;
+
+  options.parse(argc, argv);  // 解析命令列參數
 
   game.init();  // 初始化環境
 
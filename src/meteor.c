@@ -0,0 +1,294 @@
+/**
+ *  @file       meteor.c
+ *  @brief      Defines the meteor storage and its update kernels.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The meteor file.
+ **/
+
+#include <stdlib.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define UXI_METEOR_X86 1
+#endif
+
+#include "meteor.h"
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static void alloc_(MeteorStore *, int);
+static void release_(MeteorStore *);
+static int integrate_(MeteorStore *, int32_t, int32_t);
+static int integrate_range_(MeteorStore *, int, int, int32_t, int32_t);
+static int integrate_scalar_(MeteorStore *, int, int, int, int32_t, int32_t);
+
+#ifdef UXI_METEOR_X86
+static void detect_(void) __attribute__((constructor));
+static int integrate_sse2_(MeteorStore *, int, int, int32_t, int32_t);
+static int integrate_avx2_(MeteorStore *, int, int, int32_t, int32_t);
+#endif
+
+// 內部資料欄位 (private data) 宣告
+#ifdef UXI_METEOR_X86
+static int avx2_ = 0;  // 載入時由 detect_() 設定一次, 之後只讀
+#endif
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global MeteorKernel object.
+ *
+ *  @since  0.1.0
+ **/
+MeteorKernel meteor_kernel = {
+    alloc_, release_, integrate_, integrate_range_,
+};  // meteor_kernel
+
+// 函數 (方法) 的實作 (implementations)
+
+#ifdef UXI_METEOR_X86
+
+/**
+ *  Detect AVX2 once, when the program loads and before any worker
+ *  runs, so the kernels only read the result.
+ *
+ *  @since  0.1.0
+ **/
+void detect_(void) {
+  __builtin_cpu_init();
+  avx2_ = __builtin_cpu_supports("avx2") ? 1 : 0;
+}  // detect_()
+
+#endif
+
+/**
+ *  Allocate the arrays of a MeteorStore for `count` meteors.
+ *
+ *  @param MeteorStore * the store to initialize.
+ *  @param int number of meteors.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void alloc_(MeteorStore *store, int count) {
+  store->count_ = count;
+
+  store->x_ = (int32_t *)malloc(sizeof(int32_t) * count);
+  store->y_ = (int32_t *)malloc(sizeof(int32_t) * count);
+  store->w_ = (int32_t *)malloc(sizeof(int32_t) * count);
+  store->h_ = (int32_t *)malloc(sizeof(int32_t) * count);
+  store->vx_ = (int32_t *)malloc(sizeof(int32_t) * count);
+  store->vy_ = (int32_t *)malloc(sizeof(int32_t) * count);
+  store->culled_ = (int32_t *)malloc(sizeof(int32_t) * count);
+  store->hits_ = (int32_t *)malloc(sizeof(int32_t) * count);
+
+  store->flags_ = (uint8_t *)calloc(count, sizeof(uint8_t));
+  store->sprite_ = (uint8_t *)calloc(count, sizeof(uint8_t));
+}  // alloc_()
+
+/**
+ *  Release the arrays of a MeteorStore.
+ *
+ *  @since  0.1.0
+ **/
+void release_(MeteorStore *store) {
+  free(store->x_);
+  free(store->y_);
+  free(store->w_);
+  free(store->h_);
+  free(store->vx_);
+  free(store->vy_);
+  free(store->culled_);
+  free(store->hits_);
+  free(store->flags_);
+  free(store->sprite_);
+
+  store->count_ = 0;
+}  // release_()
+
+/**
+ *  Move every meteor by its velocity and collect those which left
+ *  the (width, height) scene into `culled_`, in ascending order.
+ *  Respawning the culled meteors is left to the caller.
+ *
+ *  @param MeteorStore * the meteors.
+ *  @param int32_t scene width.
+ *  @param int32_t scene height.
+ *  @return int number of culled meteors.
+ *  @since  0.1.0
+ **/
+int integrate_(MeteorStore *store, int32_t width, int32_t height) {
+  return integrate_range_(store, 0, store->count_, width, height);
+}  // integrate_()
+
+/**
+ *  integrate() over the meteors [begin, end) only.  The culled
+ *  indices are written, in ascending order, to `culled_` starting at
+ *  `culled_[begin]`, so disjoint ranges can run at the same time.
+ *
+ *  @param MeteorStore * the meteors.
+ *  @param int first meteor.
+ *  @param int one past the last meteor.
+ *  @param int32_t scene width.
+ *  @param int32_t scene height.
+ *  @return int number of culled meteors in the range.
+ *  @since  0.1.0
+ **/
+int integrate_range_(MeteorStore *store, int begin, int end, int32_t width,
+                     int32_t height) {
+#ifdef UXI_METEOR_X86
+  if (avx2_) {
+    return integrate_avx2_(store, begin, end, width, height) - begin;
+  }  // fi
+
+  return integrate_sse2_(store, begin, end, width, height) - begin;
+#else
+  return integrate_scalar_(store, begin, end, begin, width, height) - begin;
+#endif
+}  // integrate_range_()
+
+/**
+ *  Scalar kernel, also used for the tail the vector kernels leave.
+ *
+ *  @param int first meteor to process.
+ *  @param int one past the last meteor to process.
+ *  @param int where the next culled index goes in `culled_`.
+ *  @return int one past the last culled index written.
+ *  @since  0.1.0
+ **/
+int integrate_scalar_(MeteorStore *store, int from, int end, int culls,
+                      int32_t width, int32_t height) {
+  for (int i = from; i < end; ++i) {
+    store->x_[i] += store->vx_[i];
+    store->y_[i] += store->vy_[i];
+
+    if (store->y_[i] > height || (store->x_[i] + store->w_[i]) < 0 ||
+        store->x_[i] > width) {
+      store->culled_[culls++] = i;
+    }  // fi
+  }    // od
+
+  return culls;
+}  // integrate_scalar_()
+
+#ifdef UXI_METEOR_X86
+
+/**
+ *  SSE2 kernel, 4 meteors per instruction.
+ *
+ *  @since  0.1.0
+ **/
+__attribute__((target("sse2"))) int integrate_sse2_(MeteorStore *store,
+                                                    int begin, int end,
+                                                    int32_t width,
+                                                    int32_t height) {
+  __m128i const w_max = _mm_set1_epi32(width);
+  __m128i const h_max = _mm_set1_epi32(height);
+  __m128i const zero = _mm_setzero_si128();
+
+  int culls = begin;
+  int i = begin;
+
+  for (; i + 4 <= end; i += 4) {
+    __m128i x = _mm_loadu_si128((__m128i const *)(store->x_ + i));
+    __m128i y = _mm_loadu_si128((__m128i const *)(store->y_ + i));
+    __m128i w = _mm_loadu_si128((__m128i const *)(store->w_ + i));
+
+    x = _mm_add_epi32(x, _mm_loadu_si128((__m128i const *)(store->vx_ + i)));
+    y = _mm_add_epi32(y, _mm_loadu_si128((__m128i const *)(store->vy_ + i)));
+
+    _mm_storeu_si128((__m128i *)(store->x_ + i), x);
+    _mm_storeu_si128((__m128i *)(store->y_ + i), y);
+
+    __m128i out = _mm_or_si128(
+        _mm_or_si128(_mm_cmpgt_epi32(y, h_max), _mm_cmpgt_epi32(x, w_max)),
+        _mm_cmpgt_epi32(zero, _mm_add_epi32(x, w)));
+
+    unsigned mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(out));
+
+    while (mask != 0) {
+      store->culled_[culls++] = i + __builtin_ctz(mask);
+      mask &= mask - 1;
+    }  // od
+  }    // od
+
+  return integrate_scalar_(store, i, end, culls, width, height);
+}  // integrate_sse2_()
+
+/**
+ *  AVX2 kernel, 8 meteors per instruction.
+ *
+ *  @since  0.1.0
+ **/
+__attribute__((target("avx2"))) int integrate_avx2_(MeteorStore *store,
+                                                    int begin, int end,
+                                                    int32_t width,
+                                                    int32_t height) {
+  __m256i const w_max = _mm256_set1_epi32(width);
+  __m256i const h_max = _mm256_set1_epi32(height);
+  __m256i const zero = _mm256_setzero_si256();
+
+  int culls = begin;
+  int i = begin;
+
+  for (; i + 8 <= end; i += 8) {
+    __m256i x = _mm256_loadu_si256((__m256i const *)(store->x_ + i));
+    __m256i y = _mm256_loadu_si256((__m256i const *)(store->y_ + i));
+    __m256i w = _mm256_loadu_si256((__m256i const *)(store->w_ + i));
+
+    x = _mm256_add_epi32(
+        x, _mm256_loadu_si256((__m256i const *)(store->vx_ + i)));
+    y = _mm256_add_epi32(
+        y, _mm256_loadu_si256((__m256i const *)(store->vy_ + i)));
+
+    _mm256_storeu_si256((__m256i *)(store->x_ + i), x);
+    _mm256_storeu_si256((__m256i *)(store->y_ + i), y);
+
+    __m256i out = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpgt_epi32(y, h_max),
+                        _mm256_cmpgt_epi32(x, w_max)),
+        _mm256_cmpgt_epi32(zero, _mm256_add_epi32(x, w)));
+
+    unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(out));
+
+    while (mask != 0) {
+      store->culled_[culls++] = i + __builtin_ctz(mask);
+      mask &= mask - 1;
+    }  // od
+  }    // od
+
+  return integrate_scalar_(store, i, end, culls, width, height);
+}  // integrate_avx2_()
+
+#endif  // UXI_METEOR_X86
+
+// meteor.c
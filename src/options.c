@@ -0,0 +1,224 @@
+/**
+ *  @file       options.c
+ *  @brief      Parses the command-line options.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The options file.
+ **/
+
+#include <stdio.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "jobs.h"
+#include "options.h"
+
+#define RESOLUTION_MAX 16384  // headless 解析度的上限
+#define COUNT_MAX (1 << 24)     // 隕石, laser 等數量的上限
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static void parse_(int, char *[]);
+static void usage_(char const *);
+static int number_(char const *, char const *, int, int);
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global Options object, holding the defaults until parse()
+ *  is called.
+ *
+ *  @since  0.1.0
+ **/
+Options options = {
+    parse_, false, true, true, false, false, false, false, 1920, 1080, 0, 0,
+    0, 0, 0, 0, (char const *)NULL, (char const *)NULL, (char const *)NULL,
+    (char const *)NULL,
+};  // options
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Print the usage and quit.
+ *
+ *  @since  0.1.0
+ **/
+void usage_(char const *prog) {
+  printf("usage: %s [options]\n", prog);
+  printf("  --headless         render offscreen, no window needed\n");
+  printf("  --headless=none    run without rendering at all\n");
+  printf("  --no-vsync         do not wait for vsync when presenting\n");
+  printf("  --size WxH         headless resolution (1920x1080)\n");
+  printf("  --frames N         quit after N ticks\n");
+  printf("  --threads N        worker threads, CPUs by default\n");
+  printf("  --seed N           dice seed, the clock by default\n");
+  printf("  --record FILE      record the session's input to FILE\n");
+  printf("  --replay FILE      play a recorded session back\n");
+  printf("  --fast             do not throttle the simulation\n");
+  printf("  --trace FILE       write a Chrome trace (JSON) to FILE\n");
+  printf("  --stress           auto-fire along a scripted path, never die\n");
+  printf("  --meteors N        meteor count, by the scene size by default\n");
+  printf("  --lasers N         live lasers at most (4096)\n");
+  printf("  --fire-rate N      lasers per second, 2.5 by default\n");
+  printf("  --share NAME       export each tick to shared memory /NAME\n");
+  printf("  --share-frames     export the rendered frames too\n");
+
+  exit(0);
+}  // usage_()
+
+/**
+ *  Read a whole decimal number in [lo, hi]; anything else prints the
+ *  usage and quits.
+ *
+ *  @param char const * the program name, for the usage.
+ *  @param char const * the text to read.
+ *  @param int the smallest value allowed.
+ *  @param int the largest value allowed.
+ *  @return int the number.
+ *  @since  0.1.0
+ **/
+int number_(char const *prog, char const *text, int lo, int hi) {
+  char *end = (char *)NULL;
+  long value = 0;
+
+  errno = 0;
+  value = strtol(text, &end, 10);
+
+  if ((errno != 0) || (end == text) || (*end != '\0') || (value < lo) ||
+      (value > hi)) {
+    usage_(prog);
+  }  // fi
+
+  return (int)value;
+}  // number_()
+
+/**
+ *  Parse the command line into the global Options object.
+ *
+ *  @param int argc of main().
+ *  @param char *[] argv of main().
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void parse_(int argc, char *argv[]) {
+  for (int i = 1; i < argc; ++i) {
+    char const *arg = argv[i];
+    char const *next = (i + 1 < argc) ? argv[i + 1] : (char const *)NULL;
+
+    if (strcmp(arg, "--headless") == 0) {
+      options.headless_ = true;
+    }  // fi
+    else if (strcmp(arg, "--headless=none") == 0) {
+      options.headless_ = true;
+      options.render_ = false;
+    }  // fi
+    else if (strcmp(arg, "--no-vsync") == 0) {
+      options.vsync_ = false;
+    }  // fi
+    else if (strcmp(arg, "--size") == 0 && next != (char const *)NULL) {
+      if ((sscanf(next, "%dx%d", &options.width_, &options.height_) != 2) ||
+          (options.width_ < 1) || (options.width_ > RESOLUTION_MAX) ||
+          (options.height_ < 1) || (options.height_ > RESOLUTION_MAX)) {
+        usage_(argv[0]);
+      }  // fi
+
+      ++i;
+    }  // fi
+    else if (strcmp(arg, "--frames") == 0 && next != (char const *)NULL) {
+      options.frames_ = number_(argv[0], next, 0, INT_MAX);
+
+      ++i;
+    }  // fi
+    else if (strcmp(arg, "--threads") == 0 && next != (char const *)NULL) {
+      options.threads_ = number_(argv[0], next, 0, JOBS_MAX_WORKERS);
+
+      ++i;
+    }  // fi
+    else if (strcmp(arg, "--seed") == 0 && next != (char const *)NULL) {
+      options.seed_ = strtoull(next, (char **)NULL, 0);
+      options.seeded_ = true;
+
+      ++i;
+    }  // fi
+    else if (strcmp(arg, "--record") == 0 && next != (char const *)NULL) {
+      options.record_ = next;
+
+      ++i;
+    }  // fi
+    else if (strcmp(arg, "--replay") == 0 && next != (char const *)NULL) {
+      options.replay_ = next;
+
+      ++i;
+    }  // fi
+    else if (strcmp(arg, "--fast") == 0) {
+      options.fast_ = true;
+    }  // fi
+    else if (strcmp(arg, "--trace") == 0 && next != (char const *)NULL) {
+      options.trace_ = next;
+
+      ++i;
+    }  // fi
+    else if (strcmp(arg, "--stress") == 0) {
+      options.stress_ = true;
+    }  // fi
+    else if (strcmp(arg, "--meteors") == 0 && next != (char const *)NULL) {
+      options.meteors_ = number_(argv[0], next, 0, COUNT_MAX);
+
+      ++i;
+    }  // fi
+    else if (strcmp(arg, "--lasers") == 0 && next != (char const *)NULL) {
+      options.lasers_ = number_(argv[0], next, 0, COUNT_MAX);
+
+      ++i;
+    }  // fi
+    else if (strcmp(arg, "--fire-rate") == 0 && next != (char const *)NULL) {
+      options.fire_rate_ = number_(argv[0], next, 0, COUNT_MAX);
+
+      ++i;
+    }  // fi
+    else if (strcmp(arg, "--share") == 0 && next != (char const *)NULL) {
+      options.share_ = next;
+
+      ++i;
+    }  // fi
+    else if (strcmp(arg, "--share-frames") == 0) {
+      options.share_frames_ = true;
+    }  // fi
+    else {
+      usage_(argv[0]);
+    }  // esle
+  }    // od
+}  // parse_()
+
+// options.c
@@ -0,0 +1,228 @@
+/**
+ *  @file       pack.c
+ *  @brief      Defines the asset pack code.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The asset pack file.  The pack is mapped copy-on-write and images are
+ *  handed out as SDL_Surfaces whose pixels point into the mapping, so
+ *  getting an image costs no decode.  The game still copies each one
+ *  once, when it blits the image into its atlas page.
+ **/
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "pack.h"
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static bool open_(Pack *, char const *);
+static SDL_Surface *surface_(Pack const *, char const *);
+static void close_(Pack *);
+
+static bool valid_(Pack *);
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global AssetPack object.
+ *
+ *  @since  0.1.0
+ **/
+AssetPack asset_pack = {open_, surface_, close_};  // asset_pack
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Map a pack file.  A missing file is not an error, the caller falls
+ *  back to the PNGs; a damaged or outdated one is reported and
+ *  ignored.  There is no mmap on Windows, which always uses the PNGs.
+ *
+ *  @param Pack * the pack to open.
+ *  @param char const * the pack file name.
+ *  @return bool true if the pack is mapped and valid.
+ *  @since  0.1.0
+ **/
+bool open_(Pack *pack, char const *path) {
+  pack->base_ = NULL;
+  pack->size_ = 0;
+  pack->count_ = 0;
+  pack->entries_ = (PackEntry const *)NULL;
+
+#ifdef _WIN32
+  (void)path;
+
+  return false;
+#else
+  struct stat info;
+  int fd = open(path, O_RDONLY);
+
+  if (fd < 0) {
+    return false;
+  }  // fi
+
+  if ((fstat(fd, &info) < 0) || (info.st_size < (off_t)sizeof(PackHeader))) {
+    close(fd);
+
+    printf("Pack Error: %s is too short\n", path);
+
+    return false;
+  }  // fi
+
+  // 寫入時複製 (copy-on-write): 像素可安心交給 SDL, 不會改到檔案
+  pack->size_ = (size_t)info.st_size;
+  pack->base_ = mmap(NULL, pack->size_, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                     fd, 0);
+
+  close(fd);
+
+  if (pack->base_ == MAP_FAILED) {
+    printf("Pack Error: cannot map %s\n", path);
+
+    pack->base_ = NULL;
+
+    return false;
+  }  // fi
+
+  if (!valid_(pack)) {
+    printf("Pack Error: %s is damaged or outdated, rebuild it\n", path);
+
+    close_(pack);
+
+    return false;
+  }  // fi
+
+  return true;
+#endif
+}  // open_()
+
+/**
+ *  Check the header and that every entry lies inside the file, then
+ *  point the pack at its entries.
+ *
+ *  @since  0.1.0
+ **/
+bool valid_(Pack *pack) {
+  PackHeader const *header = (PackHeader const *)pack->base_;
+  PackEntry const *entries = (PackEntry const *)(header + 1);
+
+  if ((memcmp(header->magic_, PACK_MAGIC, 4) != 0) ||
+      (header->version_ != PACK_VERSION) ||
+      (header->byte_order_ != PACK_BYTE_ORDER)) {
+    return false;
+  }  // fi
+
+  if ((pack->size_ - sizeof(PackHeader)) / sizeof(PackEntry) <
+      header->count_) {
+    return false;
+  }  // fi
+
+  for (uint32_t i = 0; i < header->count_; ++i) {
+    uint64_t end = (uint64_t)entries[i].offset_ +
+                   (uint64_t)entries[i].width_ * entries[i].height_ * 4;
+
+    if ((entries[i].name_[PACK_NAME_MAX - 1] != '\0') ||
+        (end > pack->size_)) {
+      return false;
+    }  // fi
+  }    // od
+
+  pack->count_ = header->count_;
+  pack->entries_ = entries;
+
+  return true;
+}  // valid_()
+
+/**
+ *  Find an image by its file name.  The surface's pixels are the
+ *  mapping itself; it must be freed with SDL_FreeSurface() before the
+ *  pack is closed.  Safe to call from several threads at once.
+ *
+ *  @param Pack const * the pack.
+ *  @param char const * the image file name, as the PNG would be loaded.
+ *  @return SDL_Surface * the image, or NULL if the pack does not hold it.
+ *  @since  0.1.0
+ **/
+SDL_Surface *surface_(Pack const *pack, char const *name) {
+  int low = 0;
+  int high = (int)pack->count_ - 1;
+
+  // 名稱已排序, 二分搜尋
+  while (low <= high) {
+    int middle = (low + high) / 2;
+    PackEntry const *entry = &pack->entries_[middle];
+    int order = strcmp(name, entry->name_);
+
+    if (order == 0) {
+      return SDL_CreateRGBSurfaceWithFormatFrom(
+          (Uint8 *)pack->base_ + entry->offset_, (int)entry->width_,
+          (int)entry->height_, 32, (int)entry->width_ * 4,
+          SDL_PIXELFORMAT_RGBA32);
+    }  // fi
+
+    if (order < 0) {
+      high = middle - 1;
+    }  // fi
+    else {
+      low = middle + 1;
+    }  // esle
+  }    // od
+
+  return (SDL_Surface *)NULL;
+}  // surface_()
+
+/**
+ *  Unmap the pack.
+ *
+ *  @since  0.1.0
+ **/
+void close_(Pack *pack) {
+#ifndef _WIN32
+  if (pack->base_ != NULL) {
+    munmap(pack->base_, pack->size_);
+  }  // fi
+#endif
+
+  pack->base_ = NULL;
+  pack->size_ = 0;
+  pack->count_ = 0;
+  pack->entries_ = (PackEntry const *)NULL;
+}  // close_()
+
+// pack.c
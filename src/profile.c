@@ -0,0 +1,370 @@
+/**
+ *  @file       profile.c
+ *  @brief      Defines the frame profiler code.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The frame profiler file.  Keeps the timings of every phase in a ring
+ *  buffer, draws min/avg/p99 per phase as an overlay (toggled with F3),
+ *  and reports and dumps them to CSV when the game ends.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "profile.h"
+
+#define OVERLAY_X 8
+#define OVERLAY_Y 8
+#define OVERLAY_ROW 14
+#define OVERLAY_BAR 200     // 長條圖的寬度, 對應 OVERLAY_BUDGET
+#define OVERLAY_BUDGET 40.0f  // ms, 一個模擬 tick
+#define GLYPH_SCALE 2
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static char const *name_(Phase);
+static void record_(Phase, Uint32, Uint64);
+static void stats_(Phase, ProfileStats *);
+static void toggle_(void);
+static void draw_(SDL_Renderer *);
+static void report_(void);
+static bool dump_(char const *);
+
+static int by_usec_(void const *, void const *);
+static int text_(char const *, int, int, SDL_Rect *);
+
+// 內部資料欄位 (private data) 宣告
+static ProfileRing rings_[PHASE_COUNT];
+static bool visible_ = false;
+
+static char const *names_[PHASE_COUNT] = {
+    "tick",           "update_lasers", "update_meteors", "collide_lasers",
+    "collide_wings",  "frame",         "update_scene",   "present",
+};  // names_
+
+static SDL_Color const colors_[PHASE_COUNT] = {
+    {255, 255, 255, 255}, {80, 160, 255, 255}, {160, 110, 60, 255},
+    {255, 80, 80, 255},   {255, 200, 0, 255},  {200, 200, 200, 255},
+    {80, 220, 120, 255},  {200, 100, 255, 255},
+};  // colors_
+
+// 3x5 的數字字型, 每列 3 bits, 由上而下
+static Uint16 const glyphs_[11] = {
+    075557, 026227, 071747, 071717, 055711, 074717,
+    074757, 071111, 075757, 075717, 000002,
+};  // glyphs_: 0 .. 9, '.'
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global Profiler object.
+ *
+ *  @since  0.1.0
+ **/
+Profiler profiler = {
+    name_, record_, stats_, toggle_, draw_, report_, dump_,
+};  // profiler
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  The name of a phase, as it appears in reports and traces.
+ *
+ *  @since  0.1.0
+ **/
+char const *name_(Phase phase) {
+  return names_[phase];
+}  // name_()
+
+/**
+ *  Record the time since `start` as a sample of a phase.
+ *
+ *  @param Phase the phase.
+ *  @param Uint32 the tick or frame number.
+ *  @param Uint64 the performance counter when the phase began.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void record_(Phase phase, Uint32 index, Uint64 start) {
+  Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+  ProfileRing *ring = &rings_[phase];
+  Uint32 at = 0;
+
+  SDL_AtomicLock(&ring->lock_);
+
+  at = ring->count_ % PROFILE_SAMPLES;
+
+  ring->index_[at] = index;
+  ring->usec_[at] =
+      (Uint32)(elapsed * 1000000 / SDL_GetPerformanceFrequency());
+  ring->count_ += 1;
+
+  SDL_AtomicUnlock(&ring->lock_);
+}  // record_()
+
+/**
+ *  Order samples by duration.
+ *
+ *  @since  0.1.0
+ **/
+int by_usec_(void const *a, void const *b) {
+  Uint32 x = *(Uint32 const *)a;
+  Uint32 y = *(Uint32 const *)b;
+
+  return (x > y) - (x < y);
+}  // by_usec_()
+
+/**
+ *  Min, average and 99th percentile of the samples a phase still has.
+ *
+ *  @param Phase the phase.
+ *  @param ProfileStats * the result, in ms.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void stats_(Phase phase, ProfileStats *stats) {
+  static Uint32 sorted[PROFILE_SAMPLES];
+
+  ProfileRing *ring = &rings_[phase];
+  Uint32 count = 0;
+  Uint64 sum = 0;
+
+  SDL_AtomicLock(&ring->lock_);
+
+  count = (ring->count_ < PROFILE_SAMPLES) ? ring->count_ : PROFILE_SAMPLES;
+  memcpy(sorted, ring->usec_, count * sizeof(Uint32));
+
+  SDL_AtomicUnlock(&ring->lock_);
+
+  stats->count_ = count;
+  stats->min_ = 0.0f;
+  stats->avg_ = 0.0f;
+  stats->p99_ = 0.0f;
+
+  if (count == 0) {
+    return;
+  }  // fi
+
+  qsort(sorted, count, sizeof(Uint32), by_usec_);
+
+  for (Uint32 i = 0; i < count; ++i) {
+    sum += sorted[i];
+  }  // od
+
+  stats->min_ = sorted[0] / 1000.0f;
+  stats->avg_ = (float)sum / count / 1000.0f;
+  stats->p99_ = sorted[(count * 99 - 1) / 100] / 1000.0f;
+}  // stats_()
+
+/**
+ *  Show or hide the overlay.  Showing it prints which row is which.
+ *
+ *  @since  0.1.0
+ **/
+void toggle_(void) {
+  visible_ = !visible_;
+
+  if (visible_) {
+    printf("Profiler: overlay rows are min avg p99 (ms) of");
+
+    for (int i = 0; i < PHASE_COUNT; ++i) {
+      printf(" %s", names_[i]);
+    }  // od
+
+    printf("\n");
+  }  // fi
+}  // toggle_()
+
+/**
+ *  Lay out a string of digits and '.' as rects, from (x, y).
+ *
+ *  @return int the number of rects written to `rects`.
+ *  @since  0.1.0
+ **/
+int text_(char const *text, int x, int y, SDL_Rect *rects) {
+  int count = 0;
+
+  for (; *text != '\0'; ++text, x += 4 * GLYPH_SCALE) {
+    Uint16 glyph = 0;
+
+    if ((*text >= '0') && (*text <= '9')) {
+      glyph = glyphs_[*text - '0'];
+    }  // fi
+    else if (*text == '.') {
+      glyph = glyphs_[10];
+    }  // fi
+    else {
+      continue;
+    }  // esle
+
+    for (int bit = 0; bit < 15; ++bit) {
+      if (glyph & (1 << (14 - bit))) {
+        rects[count].x = x + (bit % 3) * GLYPH_SCALE;
+        rects[count].y = y + (bit / 3) * GLYPH_SCALE;
+        rects[count].w = GLYPH_SCALE;
+        rects[count].h = GLYPH_SCALE;
+
+        ++count;
+      }  // fi
+    }    // od
+  }      // od
+
+  return count;
+}  // text_()
+
+/**
+ *  Draw the overlay, if shown: one row per phase with its colour, its
+ *  min, avg and p99 in ms, and avg and p99 as bars against one tick.
+ *
+ *  @param SDL_Renderer * the renderer.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void draw_(SDL_Renderer *renderer) {
+  static SDL_Rect rects[32 * 15];
+
+  SDL_Rect box;
+
+  if (!visible_) {
+    return;
+  }  // fi
+
+  box.x = OVERLAY_X - 4;
+  box.y = OVERLAY_Y - 4;
+  box.w = 184 + OVERLAY_BAR;
+  box.h = PHASE_COUNT * OVERLAY_ROW + 6;
+
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+  SDL_RenderFillRect(renderer, &box);
+
+  for (int i = 0; i < PHASE_COUNT; ++i) {
+    ProfileStats stats;
+    SDL_Color const *color = &colors_[i];
+    char text[32];
+    int y = OVERLAY_Y + i * OVERLAY_ROW;
+    int count = 0;
+
+    stats_((Phase)i, &stats);
+
+    snprintf(text, sizeof(text), "%6.2f %6.2f %6.2f", stats.min_, stats.avg_,
+             stats.p99_);
+
+    SDL_SetRenderDrawColor(renderer, color->r, color->g, color->b, 255);
+
+    // 色塊
+    rects[0].x = OVERLAY_X;
+    rects[0].y = y;
+    rects[0].w = 10;
+    rects[0].h = 10;
+
+    count = 1 + text_(text, OVERLAY_X + 16, y, rects + 1);
+
+    // p99 與 avg 的長條, 超過一個 tick 就截斷
+    rects[count].x = OVERLAY_X + 176;
+    rects[count].y = y + 6;
+    rects[count].w = (int)(SDL_min(stats.p99_ / OVERLAY_BUDGET, 1.0f) *
+                           OVERLAY_BAR);
+    rects[count].h = 2;
+
+    rects[count + 1].x = OVERLAY_X + 176;
+    rects[count + 1].y = y + 1;
+    rects[count + 1].w = (int)(SDL_min(stats.avg_ / OVERLAY_BUDGET, 1.0f) *
+                               OVERLAY_BAR);
+    rects[count + 1].h = 4;
+
+    SDL_RenderFillRects(renderer, rects, count + 2);
+  }  // od
+}  // draw_()
+
+/**
+ *  Print min, avg and p99 of every phase.
+ *
+ *  @since  0.1.0
+ **/
+void report_(void) {
+  printf("Profile: ms over the last %d samples of each phase\n",
+         PROFILE_SAMPLES);
+  printf("  %-14s %8s %8s %8s\n", "phase", "min", "avg", "p99");
+
+  for (int i = 0; i < PHASE_COUNT; ++i) {
+    ProfileStats stats;
+
+    stats_((Phase)i, &stats);
+
+    printf("  %-14s %8.3f %8.3f %8.3f\n", names_[i], stats.min_, stats.avg_,
+           stats.p99_);
+  }  // od
+}  // report_()
+
+/**
+ *  Write the samples still in the rings to a CSV file, one line per
+ *  sample: phase, tick or frame number, and microseconds.
+ *
+ *  @param char const * the CSV file name.
+ *  @return bool false if the file cannot be written.
+ *  @since  0.1.0
+ **/
+bool dump_(char const *path) {
+  FILE *file = fopen(path, "w");
+
+  if (file == (FILE *)NULL) {
+    return false;
+  }  // fi
+
+  fprintf(file, "phase,index,usec\n");
+
+  for (int i = 0; i < PHASE_COUNT; ++i) {
+    ProfileRing *ring = &rings_[i];
+    Uint32 first = 0;
+
+    SDL_AtomicLock(&ring->lock_);
+
+    // 由最舊的樣本開始
+    if (ring->count_ > PROFILE_SAMPLES) {
+      first = ring->count_ - PROFILE_SAMPLES;
+    }  // fi
+
+    for (Uint32 n = first; n < ring->count_; ++n) {
+      Uint32 at = n % PROFILE_SAMPLES;
+
+      fprintf(file, "%s,%u,%u\n", names_[i], ring->index_[at],
+              ring->usec_[at]);
+    }  // od
+
+    SDL_AtomicUnlock(&ring->lock_);
+  }  // od
+
+  return fclose(file) == 0;
+}  // dump_()
+
+// profile.c
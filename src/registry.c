@@ -0,0 +1,289 @@
+/**
+ *  @file       registry.c
+ *  @brief      Defines the sprite registry code.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The sprite registry file.
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "registry.h"
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static void init_(Registry *, int);
+static Sprite *acquire_(Registry *, char const *, bool *);
+static void release_(Registry *, Sprite *);
+static void clear_(Registry *);
+static size_t texture_bytes_(Registry const *);
+
+static uint32_t hash_(char const *);
+static int find_(Registry const *, char const *, uint32_t);
+static void grow_(Registry *);
+static void sprite_free_(Sprite *);
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global SpriteRegistry object.
+ *
+ *  @since  0.1.0
+ **/
+SpriteRegistry sprite_registry = {
+    init_, acquire_, release_, clear_, texture_bytes_,
+};  // sprite_registry
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Initialize an empty registry.
+ *
+ *  @param Registry * the registry.
+ *  @param int the expected number of sprites; the map grows as needed.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void init_(Registry *registry, int expected) {
+  int capacity = 16;
+
+  while (capacity < expected * 2) {
+    capacity <<= 1;
+  }  // od
+
+  registry->capacity_ = capacity;
+  registry->count_ = 0;
+  registry->slots_ = (RegistrySlot *)calloc(capacity, sizeof(RegistrySlot));
+}  // init_()
+
+/**
+ *  Get the sprite of an image path.  A path already registered returns
+ *  the shared sprite and adds a reference; otherwise a new, empty
+ *  sprite named after the path is registered and the caller loads it.
+ *
+ *  @param Registry * the registry.
+ *  @param char const * the image path.
+ *  @param bool * set to true if the sprite is new and must be loaded.
+ *  @return Sprite * the sprite.
+ *  @since  0.1.0
+ **/
+Sprite *acquire_(Registry *registry, char const *path, bool *fresh) {
+  uint32_t hash = hash_(path);
+  int at = find_(registry, path, hash);
+  Sprite *sprite = (Sprite *)NULL;
+
+  if (registry->slots_[at].sprite_ != (Sprite *)NULL) {
+    registry->slots_[at].refs_ += 1;
+    *fresh = false;
+
+    return registry->slots_[at].sprite_;
+  }  // fi
+
+  if ((registry->count_ + 1) * 2 > registry->capacity_) {
+    grow_(registry);
+
+    at = find_(registry, path, hash);
+  }  // fi
+
+  sprite = (Sprite *)calloc(1, sizeof(Sprite));
+  sprite->name_ = strdup(path);
+
+  registry->slots_[at].sprite_ = sprite;
+  registry->slots_[at].hash_ = hash;
+  registry->slots_[at].refs_ = 1;
+  registry->count_ += 1;
+
+  *fresh = true;
+
+  return sprite;
+}  // acquire_()
+
+/**
+ *  Drop a reference to a sprite; the last one frees it.  Its texture
+ *  is an atlas page and is released with the atlas.
+ *
+ *  @param Registry * the registry.
+ *  @param Sprite * a sprite returned by acquire().
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void release_(Registry *registry, Sprite *sprite) {
+  int mask = registry->capacity_ - 1;
+  int at = find_(registry, sprite->name_, hash_(sprite->name_));
+  int next = 0;
+
+  if (--registry->slots_[at].refs_ > 0) {
+    return;
+  }  // fi
+
+  sprite_free_(sprite);
+
+  registry->slots_[at].sprite_ = (Sprite *)NULL;
+  registry->count_ -= 1;
+
+  // 往前搬移 (backward shift) 同一串的後續項目, 不留墓碑
+  next = (at + 1) & mask;
+
+  while (registry->slots_[next].sprite_ != (Sprite *)NULL) {
+    int home = (int)registry->slots_[next].hash_ & mask;
+
+    // home 不在 (at, next] 之間的項目可以搬到 at
+    if (((next - home) & mask) >= ((next - at) & mask)) {
+      registry->slots_[at] = registry->slots_[next];
+      registry->slots_[next].sprite_ = (Sprite *)NULL;
+
+      at = next;
+    }  // fi
+
+    next = (next + 1) & mask;
+  }  // od
+}  // release_()
+
+/**
+ *  Free every registered sprite, whatever its reference count, in one
+ *  pass over the map, and the map itself.
+ *
+ *  @since  0.1.0
+ **/
+void clear_(Registry *registry) {
+  for (int i = 0; i < registry->capacity_; ++i) {
+    if (registry->slots_[i].sprite_ != (Sprite *)NULL) {
+      sprite_free_(registry->slots_[i].sprite_);
+    }  // fi
+  }    // od
+
+  free(registry->slots_);
+
+  registry->slots_ = (RegistrySlot *)NULL;
+  registry->capacity_ = 0;
+  registry->count_ = 0;
+}  // clear_()
+
+/**
+ *  The texture memory the registered sprites take: the RGBA pixels of
+ *  their rects on the atlas pages.  Sprites not yet baked into a
+ *  texture are not counted.
+ *
+ *  @param Registry const * the registry.
+ *  @return size_t bytes.
+ *  @since  0.1.0
+ **/
+size_t texture_bytes_(Registry const *registry) {
+  size_t bytes = 0;
+
+  for (int i = 0; i < registry->capacity_; ++i) {
+    Sprite const *sprite = registry->slots_[i].sprite_;
+
+    if ((sprite != (Sprite *)NULL) && (sprite->texture_ != NULL)) {
+      bytes += (size_t)sprite->rect_.w * sprite->rect_.h * 4;
+    }  // fi
+  }    // od
+
+  return bytes;
+}  // texture_bytes_()
+
+/**
+ *  FNV-1a hash of a path.
+ *
+ *  @since  0.1.0
+ **/
+uint32_t hash_(char const *path) {
+  uint32_t hash = 2166136261u;
+
+  for (; *path != '\0'; ++path) {
+    hash = (hash ^ (uint8_t)*path) * 16777619u;
+  }  // od
+
+  return hash;
+}  // hash_()
+
+/**
+ *  The slot holding `path`, or the empty slot where it would go.
+ *
+ *  @since  0.1.0
+ **/
+int find_(Registry const *registry, char const *path, uint32_t hash) {
+  int mask = registry->capacity_ - 1;
+  int at = (int)hash & mask;
+
+  while (registry->slots_[at].sprite_ != (Sprite *)NULL) {
+    RegistrySlot const *slot = &registry->slots_[at];
+
+    if ((slot->hash_ == hash) && (strcmp(slot->sprite_->name_, path) == 0)) {
+      break;
+    }  // fi
+
+    at = (at + 1) & mask;
+  }  // od
+
+  return at;
+}  // find_()
+
+/**
+ *  Double the map and rehash every entry.
+ *
+ *  @since  0.1.0
+ **/
+void grow_(Registry *registry) {
+  RegistrySlot *old = registry->slots_;
+  int capacity = registry->capacity_;
+
+  registry->capacity_ = capacity * 2;
+  registry->slots_ =
+      (RegistrySlot *)calloc(registry->capacity_, sizeof(RegistrySlot));
+
+  for (int i = 0; i < capacity; ++i) {
+    if (old[i].sprite_ != (Sprite *)NULL) {
+      int at = find_(registry, old[i].sprite_->name_, old[i].hash_);
+
+      registry->slots_[at] = old[i];
+    }  // fi
+  }    // od
+
+  free(old);
+}  // grow_()
+
+/**
+ *  Free a sprite's mask, name and the sprite itself.
+ *
+ *  @since  0.1.0
+ **/
+void sprite_free_(Sprite *sprite) {
+  extern Collide collide;
+
+  collide.mask_release(&sprite->mask_);
+  free(sprite->name_);
+  free(sprite);
+}  // sprite_free_()
+
+// registry.c
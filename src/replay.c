@@ -0,0 +1,289 @@
+/**
+ *  @file       replay.c
+ *  @brief      Defines the input recording and replay file.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The replay file.
+ *
+ *  File layout, little-endian:
+ *
+ *    header  "LDRP", uint32 version, uint64 seed, int32 width,
+ *            int32 height, uint32 ticks, and since version 2:
+ *            int32 meteors, int32 lasers, int32 fire rate,
+ *            uint32 flags (bit 0: stress)
+ *    ticks   uint8 input bits, uint32 state hash; one per tick
+ *
+ *  The version also names the simulation the hashes come from.
+ *  Version 3 has the layout of version 2; files of versions 1 and 2
+ *  were recorded before respawned meteors took their new sprite's
+ *  size, so their hashes no longer match and they are refused.
+ **/
+
+#include <string.h>
+
+#include "replay.h"
+
+#define INPUT_UP 0x01
+#define INPUT_DOWN 0x02
+#define INPUT_LEFT 0x04
+#define INPUT_RIGHT 0x08
+#define INPUT_FIRE 0x10
+#define INPUT_QUIT 0x20
+
+#define HEADER_V1_SIZE 28
+#define HEADER_SIZE 44
+#define TICKS_OFFSET 24
+
+#define FLAG_STRESS 0x01
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static bool create_(Replay *, char const *);
+static bool open_(Replay *, char const *);
+static void write_(Replay *, Input const *, uint32_t);
+static bool read_(Replay *, Input *, uint32_t *);
+static void close_(Replay *);
+
+static void put_(uint8_t *, uint64_t, int);
+static uint64_t get_(uint8_t const *, int);
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global ReplayFile object.
+ *
+ *  @since  0.1.0
+ **/
+ReplayFile replay_file = {
+    create_, open_, write_, read_, close_,
+};  // replay_file
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Store the lowest `size` bytes of v, little-endian.
+ *
+ *  @since  0.1.0
+ **/
+void put_(uint8_t *p, uint64_t v, int size) {
+  for (int i = 0; i < size; ++i) {
+    p[i] = (uint8_t)(v >> (8 * i));
+  }  // od
+}  // put_()
+
+/**
+ *  Load a `size` byte little-endian value.
+ *
+ *  @since  0.1.0
+ **/
+uint64_t get_(uint8_t const *p, int size) {
+  uint64_t v = 0;
+
+  for (int i = size - 1; i >= 0; --i) {
+    v = (v << 8) | p[i];
+  }  // od
+
+  return v;
+}  // get_()
+
+/**
+ *  Create a replay file for recording.  The session's setup (seed,
+ *  scene size, stress setup) must already be set in the replay.
+ *
+ *  @param Replay * the replay.
+ *  @param char const * the file name.
+ *  @return bool false if the file cannot be created.
+ *  @since  0.1.0
+ **/
+bool create_(Replay *replay, char const *path) {
+  uint8_t header[HEADER_SIZE];
+
+  replay->file_ = fopen(path, "wb");
+
+  if (replay->file_ == (FILE *)NULL) {
+    return false;
+  }  // fi
+
+  replay->writing_ = true;
+  replay->ticks_ = 0;
+
+  // tick 數在 close() 時補上
+  memcpy(header, "LDRP", 4);
+  put_(header + 4, REPLAY_VERSION, 4);
+  put_(header + 8, replay->seed_, 8);
+  put_(header + 16, (uint32_t)replay->width_, 4);
+  put_(header + 20, (uint32_t)replay->height_, 4);
+  put_(header + TICKS_OFFSET, 0, 4);
+  put_(header + 28, (uint32_t)replay->meteors_, 4);
+  put_(header + 32, (uint32_t)replay->lasers_, 4);
+  put_(header + 36, (uint32_t)replay->fire_rate_, 4);
+  put_(header + 40, replay->stress_ ? FLAG_STRESS : 0, 4);
+
+  fwrite(header, 1, HEADER_SIZE, replay->file_);
+
+  return true;
+}  // create_()
+
+/**
+ *  Open a replay file for playback and read its header.
+ *
+ *  @param Replay * the replay.
+ *  @param char const * the file name.
+ *  @return bool false if the file cannot be read or is not a replay
+ *          of a known version.
+ *  @since  0.1.0
+ **/
+bool open_(Replay *replay, char const *path) {
+  uint8_t header[HEADER_SIZE];
+  uint32_t version = 0;
+
+  replay->file_ = fopen(path, "rb");
+
+  if (replay->file_ == (FILE *)NULL) {
+    return false;
+  }  // fi
+
+  replay->writing_ = false;
+
+  if ((fread(header, 1, HEADER_V1_SIZE, replay->file_) == HEADER_V1_SIZE) &&
+      (memcmp(header, "LDRP", 4) == 0)) {
+    version = (uint32_t)get_(header + 4, 4);
+  }  // fi
+
+  // 版本 2 起的 header 多了 stress 的設定
+  if (version == REPLAY_VERSION) {
+    if (fread(header + HEADER_V1_SIZE, 1, HEADER_SIZE - HEADER_V1_SIZE,
+              replay->file_) != HEADER_SIZE - HEADER_V1_SIZE) {
+      version = 0;
+    }  // fi
+  }    // fi
+  else if ((version > 0) && (version < REPLAY_VERSION)) {
+    printf("Replay Error: %s is version %u, recorded by an older "
+           "simulation; version %d expected, record it again\n",
+           path, version, REPLAY_VERSION);
+    version = 0;
+  }  // fi
+  else {
+    version = 0;
+  }  // esle
+
+  if (version == 0) {
+    fclose(replay->file_);
+    replay->file_ = (FILE *)NULL;
+
+    return false;
+  }  // fi
+
+  replay->seed_ = get_(header + 8, 8);
+  replay->width_ = (int32_t)get_(header + 16, 4);
+  replay->height_ = (int32_t)get_(header + 20, 4);
+  replay->ticks_ = (uint32_t)get_(header + TICKS_OFFSET, 4);
+  replay->meteors_ = (int32_t)get_(header + 28, 4);
+  replay->lasers_ = (int32_t)get_(header + 32, 4);
+  replay->fire_rate_ = (int32_t)get_(header + 36, 4);
+  replay->stress_ = (get_(header + 40, 4) & FLAG_STRESS) != 0;
+
+  return true;
+}  // open_()
+
+/**
+ *  Append one tick: its input and the hash of the state after it.
+ *
+ *  @since  0.1.0
+ **/
+void write_(Replay *replay, Input const *input, uint32_t hash) {
+  uint8_t record[5];
+
+  record[0] = (input->up_ ? INPUT_UP : 0) | (input->down_ ? INPUT_DOWN : 0) |
+              (input->left_ ? INPUT_LEFT : 0) |
+              (input->right_ ? INPUT_RIGHT : 0) |
+              (input->fire_ ? INPUT_FIRE : 0) |
+              (input->quit_ ? INPUT_QUIT : 0);
+  put_(record + 1, hash, 4);
+
+  fwrite(record, 1, sizeof(record), replay->file_);
+
+  replay->ticks_ += 1;
+}  // write_()
+
+/**
+ *  Read the next tick.
+ *
+ *  @param Replay * the replay.
+ *  @param Input * the recorded input.
+ *  @param uint32_t * the recorded state hash.
+ *  @return bool false at the end of the replay.
+ *  @since  0.1.0
+ **/
+bool read_(Replay *replay, Input *input, uint32_t *hash) {
+  uint8_t record[5];
+
+  if (fread(record, 1, sizeof(record), replay->file_) != sizeof(record)) {
+    return false;
+  }  // fi
+
+  input->up_ = (record[0] & INPUT_UP) != 0;
+  input->down_ = (record[0] & INPUT_DOWN) != 0;
+  input->left_ = (record[0] & INPUT_LEFT) != 0;
+  input->right_ = (record[0] & INPUT_RIGHT) != 0;
+  input->fire_ = (record[0] & INPUT_FIRE) != 0;
+  input->quit_ = (record[0] & INPUT_QUIT) != 0;
+
+  *hash = (uint32_t)get_(record + 1, 4);
+
+  return true;
+}  // read_()
+
+/**
+ *  Close a replay; a recording gets its tick count written.
+ *
+ *  @since  0.1.0
+ **/
+void close_(Replay *replay) {
+  uint8_t ticks[4];
+
+  if (replay->file_ == (FILE *)NULL) {
+    return;
+  }  // fi
+
+  if (replay->writing_) {
+    put_(ticks, replay->ticks_, 4);
+
+    fseek(replay->file_, TICKS_OFFSET, SEEK_SET);
+    fwrite(ticks, 1, sizeof(ticks), replay->file_);
+  }  // fi
+
+  fclose(replay->file_);
+  replay->file_ = (FILE *)NULL;
+}  // close_()
+
+// replay.c
@@ -0,0 +1,710 @@
+/**
+ *  @file       save.c
+ *  @brief      Defines the world saves.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The world saves.
+ *
+ *  Save layout, little-endian (the arrays are copied as they are in
+ *  memory, which is little-endian on every host the game builds for):
+ *
+ *    header   "LDWS", uint32 version, uint32 size, uint32 tick,
+ *             uint64 seed, int32 width, height, meteors, lasers,
+ *             fire rate, flags (bit 0: stress), kinds,
+ *             uint64 dice state[4],
+ *             int32 cell width, cell height, objects,
+ *             int32 alive, health, lives, uint32 next shot,
+ *             int32 x, y, last x, last y, kills, damage,
+ *             int32 meteor count n, laser capacity, laser count m
+ *    meteors  int32 x[n], y[n], w[n], h[n], vx[n], vy[n],
+ *             uint8 flags[n], kind[n]
+ *    lasers   int32 x[m], y[m], w[m], h[m], velocity[m], idx[m],
+ *             frame[m], exploding idx[m], uint8 flags[m]; live order
+ *
+ *  Delta layout: "LDWD", uint32 version, uint32 base size, uint32 base
+ *  tick, uint32 size, then runs up to size: varint n bytes as in the
+ *  base, varint k, k bytes of the new save.
+ **/
+
+#include <string.h>
+
+#include "laser.h"
+#include "save.h"
+
+#define LASER_BODY 0x01
+#define LASER_EXPLODING 0x02
+#define LASER_VISIBLE 0x04
+
+#define FLAG_STRESS 0x01
+
+#define METEOR_BYTES 26  // 每顆隕石: 6 個 int32 與 2 個 uint8
+#define LASER_BYTES 33   // 每個 laser: 8 個 int32 與 1 個 uint8
+#define COUNTS_OFFSET 136
+#define RUN_MIN 8        // 短於此的相同區段併入 literal, 省下 run 的開銷
+#define REACH (1 << 24)  // 座標與速度的上限, 加減不會溢位
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static size_t bound_(World const *);
+static size_t save_(World const *, uint8_t *, size_t);
+static bool load_(World *, uint8_t const *, size_t);
+static bool config_(uint8_t const *, size_t, WorldConfig *);
+static size_t delta_(uint8_t const *, size_t, uint8_t const *, size_t,
+                     uint8_t *, size_t);
+static size_t patch_(uint8_t const *, size_t, uint8_t const *, size_t,
+                     uint8_t *, size_t);
+
+static size_t size_of_(int32_t, int32_t);
+static bool valid_(uint8_t const *, size_t, char const *);
+static void put_(uint8_t **, uint64_t, int);
+static uint64_t get_(uint8_t const **, int);
+static int32_t get_int_(uint8_t const **);
+static int put_varint_(uint8_t *, uint64_t);
+static int get_varint_(uint8_t const *, uint8_t const *, uint64_t *);
+static size_t same_(uint8_t const *, uint8_t const *, size_t);
+static int32_t int_at_(uint8_t const *, int32_t);
+static bool within_(int32_t, int32_t, int32_t);
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global WorldSaver object.
+ *
+ *  @since  0.1.0
+ **/
+WorldSaver world_saver = {
+    bound_, save_, load_, config_, delta_, patch_,
+};  // world_saver
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  The largest save of a world, with every laser of its pool live.
+ *  Buffers of this size hold any save of the world.
+ *
+ *  @since  0.1.0
+ **/
+size_t bound_(World const *world) {
+  return size_of_(world->scene_.meteors_.count_,
+                  world->scene_.lasers_.capacity_);
+}  // bound_()
+
+/**
+ *  Save a world.
+ *
+ *  @param World const * the world.
+ *  @param uint8_t * where to write the save.
+ *  @param size_t the room at `out`.
+ *  @return size_t the size of the save, 0 if it does not fit.
+ *  @since  0.1.0
+ **/
+size_t save_(World const *world, uint8_t *out, size_t capacity) {
+  extern LaserAllocator laser_allocator;
+
+  WorldConfig const *config = &world->config_;
+  Scene const *scene = &world->scene_;
+  MeteorStore const *meteors = &scene->meteors_;
+  LaserPool const *pool = &scene->lasers_;
+  Wings const *wings = &world->wings_;
+
+  size_t const n = (size_t)meteors->count_;
+  size_t const m = (size_t)pool->count_;
+  size_t const size = size_of_(meteors->count_, pool->count_);
+
+  uint8_t *p = out;
+  uint8_t *column[9];
+
+  if (size > capacity) {
+    return 0;
+  }  // fi
+
+  memcpy(p, "LDWS", 4);
+  p += 4;
+
+  put_(&p, SAVE_VERSION, 4);
+  put_(&p, size, 4);
+  put_(&p, world->tick_, 4);
+
+  put_(&p, config->seed_, 8);
+  put_(&p, (uint32_t)config->width_, 4);
+  put_(&p, (uint32_t)config->height_, 4);
+  put_(&p, (uint32_t)config->meteors_, 4);
+  put_(&p, (uint32_t)config->lasers_, 4);
+  put_(&p, (uint32_t)config->fire_rate_, 4);
+  put_(&p, config->stress_ ? FLAG_STRESS : 0, 4);
+  put_(&p, (uint32_t)config->kinds_, 4);
+
+  for (int i = 0; i < 4; ++i) {
+    put_(&p, world->dice_.s_[i], 8);
+  }  // od
+
+  put_(&p, (uint32_t)scene->cell_.x, 4);
+  put_(&p, (uint32_t)scene->cell_.y, 4);
+  put_(&p, (uint32_t)scene->obj_counts_, 4);
+
+  put_(&p, wings->alive ? 1 : 0, 4);
+  put_(&p, (uint32_t)wings->health, 4);
+  put_(&p, (uint32_t)wings->num_life, 4);
+  put_(&p, wings->shot_laser_next_time, 4);
+  put_(&p, (uint32_t)wings->position_.x, 4);
+  put_(&p, (uint32_t)wings->position_.y, 4);
+  put_(&p, (uint32_t)wings->last_position_.x, 4);
+  put_(&p, (uint32_t)wings->last_position_.y, 4);
+  put_(&p, (uint32_t)world->kills_, 4);
+  put_(&p, (uint32_t)world->damage_, 4);
+
+  put_(&p, n, 4);
+  put_(&p, (uint32_t)pool->capacity_, 4);
+  put_(&p, m, 4);
+
+  // 隕石本來就是 structure of arrays, 整欄複製
+  memcpy(p, meteors->x_, n * 4);
+  memcpy(p + n * 4, meteors->y_, n * 4);
+  memcpy(p + n * 8, meteors->w_, n * 4);
+  memcpy(p + n * 12, meteors->h_, n * 4);
+  memcpy(p + n * 16, meteors->vx_, n * 4);
+  memcpy(p + n * 20, meteors->vy_, n * 4);
+  memcpy(p + n * 24, meteors->flags_, n);
+  memcpy(p + n * 25, meteors->sprite_, n);
+  p += n * METEOR_BYTES;
+
+  // laser 依存活的順序拆成各欄
+  for (int k = 0; k < 9; ++k) {
+    column[k] = p + m * 4 * k;
+  }  // od
+
+  for (int j = 0; j < pool->count_; ++j) {
+    Laser const *laser = laser_allocator.at(pool, j);
+
+    put_(&column[0], (uint32_t)laser->box_.x, 4);
+    put_(&column[1], (uint32_t)laser->box_.y, 4);
+    put_(&column[2], (uint32_t)laser->box_.w, 4);
+    put_(&column[3], (uint32_t)laser->box_.h, 4);
+    put_(&column[4], (uint32_t)laser->velocity_, 4);
+    put_(&column[5], (uint32_t)laser->idx, 4);
+    put_(&column[6], (uint32_t)laser->frame_, 4);
+    put_(&column[7], (uint32_t)laser->exploding_idx, 4);
+    put_(&column[8],
+         (laser->body_enable ? LASER_BODY : 0) |
+             (laser->exploding ? LASER_EXPLODING : 0) |
+             (laser->visible_ ? LASER_VISIBLE : 0),
+         1);
+  }  // od
+
+  return size;
+}  // save_()
+
+/**
+ *  Restore a world from a save.  The world must have been made with
+ *  the same scene size, meteor count, laser pool capacity and kinds
+ *  of meteors as the saved one; the seed, fire rate and stress mode
+ *  are taken from the save.  A save that does not fit is refused and
+ *  the world left as it was: every meteor and laser box must be of its
+ *  shape's size, and positions and velocities within REACH pixels.
+ *
+ *  @param World * the world.
+ *  @param uint8_t const * the save.
+ *  @param size_t its size.
+ *  @return bool false if the save is damaged or does not fit.
+ *  @since  0.1.0
+ **/
+bool load_(World *world, uint8_t const *blob, size_t size) {
+  extern LaserAllocator laser_allocator;
+
+  WorldConfig *config = &world->config_;
+  Scene *scene = &world->scene_;
+  MeteorStore *meteors = &scene->meteors_;
+  LaserPool *pool = &scene->lasers_;
+  Wings *wings = &world->wings_;
+  WorldConfig saved;
+
+  uint8_t const *p = blob + COUNTS_OFFSET;
+  uint8_t const *column[9];
+  int32_t n = 0;
+  int32_t capacity = 0;
+  int32_t m = 0;
+
+  if (!config_(blob, size, &saved)) {
+    return false;
+  }  // fi
+
+  n = get_int_(&p);
+  capacity = get_int_(&p);
+  m = get_int_(&p);
+
+  if ((saved.width_ != config->width_) ||
+      (saved.height_ != config->height_) ||
+      (saved.kinds_ != config->kinds_) || (n != meteors->count_) ||
+      (capacity != pool->capacity_) || (m < 0) || (m > capacity) ||
+      (size != size_of_(n, m))) {
+    return false;
+  }  // fi
+
+  // 先檢查所有的欄位, 不合的 save 不改動 world: 外框須與造型一樣大,
+  // 位置與速度在 REACH 之內, index 在範圍內
+  for (int32_t k = 0; k < 4; ++k) {
+    if (!within_(int_at_(blob + 112, k), -REACH, REACH)) {
+      return false;
+    }  // fi
+  }    // od
+
+  if (!within_(int_at_(blob + 84, 0), 1, REACH) ||
+      !within_(int_at_(blob + 84, 1), 1, REACH)) {
+    return false;
+  }  // fi
+
+  for (int32_t i = 0; i < n; ++i) {
+    uint8_t kind = p[(size_t)n * 25 + i];
+    Shape const *shape = (Shape const *)NULL;
+
+    if (kind >= config->kinds_) {
+      return false;
+    }  // fi
+
+    shape = &config->meteor_shapes_[kind];
+
+    if ((int_at_(p + (size_t)n * 8, i) != shape->w_) ||
+        (int_at_(p + (size_t)n * 12, i) != shape->h_) ||
+        !within_(int_at_(p, i), -REACH, REACH) ||
+        !within_(int_at_(p + (size_t)n * 4, i), -REACH, REACH) ||
+        !within_(int_at_(p + (size_t)n * 16, i), -REACH, REACH) ||
+        !within_(int_at_(p + (size_t)n * 20, i), -REACH, REACH)) {
+      return false;
+    }  // fi
+  }    // od
+
+  for (int32_t k = 0; k < 9; ++k) {
+    column[k] = p + (size_t)n * METEOR_BYTES + (size_t)m * 4 * k;
+  }  // od
+
+  for (int32_t j = 0; j < m; ++j) {
+    if ((int_at_(column[2], j) != config->laser_.w_) ||
+        (int_at_(column[3], j) != config->laser_.h_) ||
+        !within_(int_at_(column[0], j), -REACH, REACH) ||
+        !within_(int_at_(column[1], j), -REACH, REACH) ||
+        !within_(int_at_(column[4], j), -REACH, REACH) ||
+        !within_(int_at_(column[5], j), 0, REACH) ||
+        !within_(int_at_(column[6], j), 0, LASER_FRAMES - 1) ||
+        !within_(int_at_(column[7], j), 0, REACH)) {
+      return false;
+    }  // fi
+  }    // od
+
+  p = blob + 12;
+
+  world->tick_ = (uint32_t)get_(&p, 4);
+
+  config->seed_ = saved.seed_;
+  config->fire_rate_ = saved.fire_rate_;
+  config->stress_ = saved.stress_;
+  p += 36;  // 設定已由 config_() 讀取
+
+  for (int i = 0; i < 4; ++i) {
+    world->dice_.s_[i] = get_(&p, 8);
+  }  // od
+
+  scene->cell_.x = get_int_(&p);
+  scene->cell_.y = get_int_(&p);
+  scene->obj_counts_ = get_int_(&p);
+
+  wings->alive = get_int_(&p) != 0;
+  wings->health = get_int_(&p);
+  wings->num_life = get_int_(&p);
+  wings->shot_laser_next_time = (uint32_t)get_(&p, 4);
+  wings->position_.x = get_int_(&p);
+  wings->position_.y = get_int_(&p);
+  wings->last_position_.x = get_int_(&p);
+  wings->last_position_.y = get_int_(&p);
+  world->kills_ = get_int_(&p);
+  world->damage_ = get_int_(&p);
+
+  p += 12;  // 數量已讀取
+
+  memcpy(meteors->x_, p, (size_t)n * 4);
+  memcpy(meteors->y_, p + (size_t)n * 4, (size_t)n * 4);
+  memcpy(meteors->w_, p + (size_t)n * 8, (size_t)n * 4);
+  memcpy(meteors->h_, p + (size_t)n * 12, (size_t)n * 4);
+  memcpy(meteors->vx_, p + (size_t)n * 16, (size_t)n * 4);
+  memcpy(meteors->vy_, p + (size_t)n * 20, (size_t)n * 4);
+  memcpy(meteors->flags_, p + (size_t)n * 24, (size_t)n);
+  memcpy(meteors->sprite_, p + (size_t)n * 25, (size_t)n);
+  p += (size_t)n * METEOR_BYTES;
+
+  // laser 依序重新配置: slot 可能不同, 存活的順序不變
+  for (int k = 0; k < 9; ++k) {
+    column[k] = p + (size_t)m * 4 * k;
+  }  // od
+
+  laser_allocator.clear(pool);
+
+  for (int32_t j = 0; j < m; ++j) {
+    Laser *laser = laser_allocator.alloc(pool);
+    uint8_t flags = 0;
+
+    laser->box_.x = get_int_(&column[0]);
+    laser->box_.y = get_int_(&column[1]);
+    laser->box_.w = get_int_(&column[2]);
+    laser->box_.h = get_int_(&column[3]);
+    laser->velocity_ = get_int_(&column[4]);
+    laser->idx = get_int_(&column[5]);
+    laser->frame_ = get_int_(&column[6]);
+    laser->exploding_idx = get_int_(&column[7]);
+
+    flags = (uint8_t)get_(&column[8], 1);
+
+    laser->body_enable = (flags & LASER_BODY) != 0;
+    laser->exploding = (flags & LASER_EXPLODING) != 0;
+    laser->visible_ = (flags & LASER_VISIBLE) != 0;
+  }  // od
+
+  return true;
+}  // load_()
+
+/**
+ *  Read the config a saved world was made from, to make a world a
+ *  save can be loaded into.  The shapes are not saved: they are left
+ *  zero for the caller to set.
+ *
+ *  @param uint8_t const * the save.
+ *  @param size_t its size.
+ *  @param WorldConfig * the config to fill in.
+ *  @return bool false if it is not a save of this version.
+ *  @since  0.1.0
+ **/
+bool config_(uint8_t const *blob, size_t size, WorldConfig *config) {
+  uint8_t const *p = blob + 16;
+
+  if (!valid_(blob, size, "LDWS") || (size < SAVE_HEADER_SIZE)) {
+    return false;
+  }  // fi
+
+  memset(config, 0, sizeof(WorldConfig));
+
+  config->seed_ = get_(&p, 8);
+  config->width_ = get_int_(&p);
+  config->height_ = get_int_(&p);
+  config->meteors_ = get_int_(&p);
+  config->lasers_ = get_int_(&p);
+  config->fire_rate_ = get_int_(&p);
+  config->stress_ = (get_(&p, 4) & FLAG_STRESS) != 0;
+  config->kinds_ = get_int_(&p);
+
+  return true;
+}  // config_()
+
+/**
+ *  Encode the save `blob` against an earlier save `base` of the same
+ *  world: the runs of bytes the two share are skipped, the rest
+ *  copied.  Between two ticks most of a save is unchanged (sizes,
+ *  kinds, the high bytes of positions), so the delta is a fraction of
+ *  the save.
+ *
+ *  @param uint8_t const * the base save.
+ *  @param size_t its size.
+ *  @param uint8_t const * the new save.
+ *  @param size_t its size.
+ *  @param uint8_t * where to write the delta.
+ *  @param size_t the room at `out`.
+ *  @return size_t the size of the delta, 0 if it does not fit; keep
+ *          the save itself then.
+ *  @since  0.1.0
+ **/
+size_t delta_(uint8_t const *base, size_t base_size, uint8_t const *blob,
+              size_t size, uint8_t *out, size_t capacity) {
+  uint8_t const *tick = base + 12;
+  size_t const common = (base_size < size) ? base_size : size;
+
+  uint8_t *p = out;
+  size_t i = 0;
+
+  if (!valid_(base, base_size, "LDWS") || !valid_(blob, size, "LDWS") ||
+      (capacity < DELTA_HEADER_SIZE)) {
+    return 0;
+  }  // fi
+
+  memcpy(p, "LDWD", 4);
+  p += 4;
+
+  put_(&p, SAVE_VERSION, 4);
+  put_(&p, base_size, 4);
+  put_(&p, get_(&tick, 4), 4);
+  put_(&p, size, 4);
+
+  while (i < size) {
+    size_t run = (i < common) ? same_(base + i, blob + i, common - i) : 0;
+    size_t from = i + run;
+    size_t to = from;
+
+    // literal 延伸到下一段夠長的相同區段為止; 短的相同區段整段略過
+    while (to < size) {
+      size_t short_run = 0;
+
+      if ((to < common) && (base[to] == blob[to])) {
+        short_run = same_(base + to, blob + to, common - to);
+
+        if ((short_run >= RUN_MIN) || (to + short_run == size)) {
+          break;
+        }  // fi
+      }    // fi
+
+      to += (short_run > 0) ? short_run : 1;
+    }  // od
+
+    // varint 最多 10 bytes
+    if ((size_t)(p - out) + 20 + (to - from) > capacity) {
+      return 0;
+    }  // fi
+
+    p += put_varint_(p, run);
+    p += put_varint_(p, to - from);
+
+    memcpy(p, blob + from, to - from);
+    p += to - from;
+
+    i = to;
+  }  // od
+
+  return (size_t)(p - out);
+}  // delta_()
+
+/**
+ *  Rebuild a save from its base and a delta made by delta().
+ *
+ *  @param uint8_t const * the base save the delta was made against.
+ *  @param size_t its size.
+ *  @param uint8_t const * the delta.
+ *  @param size_t its size.
+ *  @param uint8_t * where to write the save.
+ *  @param size_t the room at `out`.
+ *  @return size_t the size of the save, 0 if the delta is damaged,
+ *          made against another base or does not fit.
+ *  @since  0.1.0
+ **/
+size_t patch_(uint8_t const *base, size_t base_size, uint8_t const *delta,
+              size_t delta_size, uint8_t *out, size_t capacity) {
+  uint8_t const *p = delta + 8;
+  uint8_t const *tick = base + 12;
+  uint8_t const *end = delta + delta_size;
+  size_t size = 0;
+  size_t o = 0;
+
+  if (!valid_(base, base_size, "LDWS") ||
+      !valid_(delta, delta_size, "LDWD") ||
+      (delta_size < DELTA_HEADER_SIZE)) {
+    return 0;
+  }  // fi
+
+  if ((get_(&p, 4) != base_size) || (get_(&p, 4) != get_(&tick, 4))) {
+    return 0;
+  }  // fi
+
+  size = (size_t)get_(&p, 4);
+
+  if (size > capacity) {
+    return 0;
+  }  // fi
+
+  while (o < size) {
+    uint64_t run = 0;
+    uint64_t literal = 0;
+    int used = get_varint_(p, end, &run);
+
+    p += used;
+    used = (used > 0) ? get_varint_(p, end, &literal) : 0;
+    p += used;
+
+    if ((used == 0) || (run > base_size - o) || (run > size - o) ||
+        (literal > size - o - run) || (literal > (uint64_t)(end - p))) {
+      return 0;
+    }  // fi
+
+    memcpy(out + o, base + o, run);
+    memcpy(out + o + run, p, literal);
+
+    o += run + literal;
+    p += literal;
+  }  // od
+
+  return (p == end) ? size : 0;
+}  // patch_()
+
+/**
+ *  The size of a save of `meteors` meteors and `lasers` live lasers.
+ *
+ *  @since  0.1.0
+ **/
+size_t size_of_(int32_t meteors, int32_t lasers) {
+  return SAVE_HEADER_SIZE + (size_t)meteors * METEOR_BYTES +
+         (size_t)lasers * LASER_BYTES;
+}  // size_of_()
+
+/**
+ *  Whether `blob` starts with `magic`, is of this version and is as
+ *  long as it says.
+ *
+ *  @since  0.1.0
+ **/
+bool valid_(uint8_t const *blob, size_t size, char const *magic) {
+  uint8_t const *p = blob + 4;
+
+  if ((size < 16) || (memcmp(blob, magic, 4) != 0)) {
+    return false;
+  }  // fi
+
+  if (get_(&p, 4) != SAVE_VERSION) {
+    return false;
+  }  // fi
+
+  // delta 的第 3 欄是 base 的大小, 不是自己的
+  return (magic[3] == 'D') || (get_(&p, 4) == size);
+}  // valid_()
+
+/**
+ *  Store the lowest `size` bytes of v, little-endian, and move past
+ *  them.
+ *
+ *  @since  0.1.0
+ **/
+void put_(uint8_t **p, uint64_t v, int size) {
+  for (int i = 0; i < size; ++i) {
+    (*p)[i] = (uint8_t)(v >> (8 * i));
+  }  // od
+
+  *p += size;
+}  // put_()
+
+/**
+ *  Load a `size` byte little-endian value and move past it.
+ *
+ *  @since  0.1.0
+ **/
+uint64_t get_(uint8_t const **p, int size) {
+  uint64_t v = 0;
+
+  for (int i = size - 1; i >= 0; --i) {
+    v = (v << 8) | (*p)[i];
+  }  // od
+
+  *p += size;
+
+  return v;
+}  // get_()
+
+/**
+ *  Load an int32 and move past it.
+ *
+ *  @since  0.1.0
+ **/
+int32_t get_int_(uint8_t const **p) {
+  return (int32_t)(uint32_t)get_(p, 4);
+}  // get_int_()
+
+/**
+ *  Store v as a LEB128 varint.
+ *
+ *  @return int the bytes written, 1 .. 10.
+ *  @since  0.1.0
+ **/
+int put_varint_(uint8_t *p, uint64_t v) {
+  int n = 0;
+
+  while (v >= 0x80) {
+    p[n++] = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }  // od
+
+  p[n++] = (uint8_t)v;
+
+  return n;
+}  // put_varint_()
+
+/**
+ *  Load a LEB128 varint from [p, end).
+ *
+ *  @return int the bytes read, 0 if the varint is cut off.
+ *  @since  0.1.0
+ **/
+int get_varint_(uint8_t const *p, uint8_t const *end, uint64_t *v) {
+  *v = 0;
+
+  for (int n = 0; (n < 10) && (p + n < end); ++n) {
+    *v |= (uint64_t)(p[n] & 0x7f) << (7 * n);
+
+    if ((p[n] & 0x80) == 0) {
+      return n + 1;
+    }  // fi
+  }    // od
+
+  return 0;
+}  // get_varint_()
+
+/**
+ *  The i-th int32 of a saved column.
+ *
+ *  @since  0.1.0
+ **/
+int32_t int_at_(uint8_t const *column, int32_t i) {
+  uint8_t const *p = column + (size_t)i * 4;
+
+  return get_int_(&p);
+}  // int_at_()
+
+/**
+ *  Whether lo <= v <= hi.
+ *
+ *  @since  0.1.0
+ **/
+bool within_(int32_t v, int32_t lo, int32_t hi) {
+  return (v >= lo) && (v <= hi);
+}  // within_()
+
+/**
+ *  The length of the common prefix of a and b, up to `size` bytes;
+ *  8 bytes at a time while they agree.
+ *
+ *  @since  0.1.0
+ **/
+size_t same_(uint8_t const *a, uint8_t const *b, size_t size) {
+  size_t i = 0;
+
+  while ((i + 8 <= size) && (memcmp(a + i, b + i, 8) == 0)) {
+    i += 8;
+  }  // od
+
+  while ((i < size) && (a[i] == b[i])) {
+    i += 1;
+  }  // od
+
+  return i;
+}  // same_()
+
+// save.c
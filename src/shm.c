@@ -0,0 +1,548 @@
+/**
+ *  @file       shm.c
+ *  @brief      Defines the shared memory export.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The shared memory export.  A state is published from the simulation
+ *  thread and a frame from the renderer, each into its own ring of
+ *  slots, so neither ever waits for the other or for a reader.
+ **/
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "laser.h"
+#include "shm.h"
+
+#define SHM_ALIGN 64  // slot 以 cache line 對齊, 避免 false sharing
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static bool create_(ShmRing *, char const *, int, int, int);
+static bool attach_(ShmRing *, char const *);
+static void close_(ShmRing *);
+static void publish_(ShmRing *, World const *);
+static void *frame_begin_(ShmRing *, int *, int *, int *);
+static void frame_end_(ShmRing *, uint32_t);
+static ShmState const *state_(ShmRing const *, int *);
+static ShmFrame const *frame_(ShmRing const *, int *);
+static bool valid_(SDL_atomic_t const *, int);
+static ShmEntity const *entities_(ShmState const *);
+
+static bool map_(ShmRing *, char const *, size_t);
+static uint8_t *slot_(ShmHeader const *, uint64_t, uint32_t, int);
+static bool fits_(ShmRing const *, uint64_t, uint64_t, uint64_t);
+static void write_begin_(SDL_atomic_t *);
+static void write_end_(SDL_atomic_t *);
+static int read_begin_(SDL_atomic_t const *);
+static size_t align_(size_t);
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global ShmExport object.
+ *
+ *  @since  0.1.0
+ **/
+ShmExport shm_export = {
+    create_, attach_, close_,  publish_, frame_begin_,
+    frame_end_, state_, frame_, valid_, entities_,
+};  // shm_export
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Create (or replace) the shared memory object `name` for states of
+ *  up to `entities` meteors and lasers and, unless `frame_w` is 0,
+ *  frames of `frame_w` x `frame_h` pixels.
+ *
+ *  @param ShmRing * the mapping to initialize.
+ *  @param char const * the object's name, "/" is prepended if needed.
+ *  @param int meteors plus lasers per state at most.
+ *  @param int frame width, 0 for no frames.
+ *  @param int frame height.
+ *  @return bool false if the object cannot be created.
+ *  @since  0.1.0
+ **/
+bool create_(ShmRing *ring, char const *name, int entities, int frame_w,
+             int frame_h) {
+  ShmHeader *header = (ShmHeader *)NULL;
+
+  size_t const state_size =
+      align_(sizeof(ShmState) + sizeof(ShmEntity) * (size_t)entities);
+  size_t const frame_size =
+      (frame_w > 0) ? align_(sizeof(ShmFrame) + (size_t)frame_w * frame_h * 4)
+                    : 0;
+  size_t const states = align_(sizeof(ShmHeader));
+  size_t const frames = states + state_size * SHM_SLOTS;
+
+  if (!map_(ring, name, frames + frame_size * SHM_SLOTS)) {
+    return false;
+  }  // fi
+
+  ring->owner_ = true;
+
+  // ftruncate() 後內容全為 0: 每個 slot 的 seq_ 為 0 (偶數)
+  header = ring->header_;
+
+  header->magic_ = SHM_MAGIC;
+  header->version_ = SHM_VERSION;
+  header->slots_ = SHM_SLOTS;
+  header->max_entities_ = (uint32_t)entities;
+  header->state_size_ = (uint32_t)state_size;
+  header->frame_size_ = (uint32_t)frame_size;
+  header->state_offset_ = states;
+  header->frame_offset_ = frames;
+
+  for (int i = 0; (frame_size > 0) && (i < SHM_SLOTS); ++i) {
+    ShmFrame *frame = (ShmFrame *)slot_(header, frames, header->frame_size_, i);
+
+    frame->w_ = frame_w;
+    frame->h_ = frame_h;
+    frame->pitch_ = frame_w * 4;
+  }  // od
+
+  return true;
+}  // create_()
+
+/**
+ *  Map an existing object read-only, as a reader.  The layout in the
+ *  header is checked against the mapping, so a truncated or foreign
+ *  object is refused rather than read past its end.
+ *
+ *  @return bool false if it does not exist, is not a ShmHeader of
+ *          this version or its rings do not fit in it.
+ *  @since  0.1.0
+ **/
+bool attach_(ShmRing *ring, char const *name) {
+  ShmHeader const *header = (ShmHeader const *)NULL;
+
+  if (!map_(ring, name, 0)) {
+    return false;
+  }  // fi
+
+  ring->owner_ = false;
+  header = ring->header_;
+
+  if ((header->magic_ != SHM_MAGIC) || (header->version_ != SHM_VERSION) ||
+      (header->slots_ == 0) ||
+      !fits_(ring, header->state_offset_, header->state_size_,
+             sizeof(ShmState) +
+                 (uint64_t)header->max_entities_ * sizeof(ShmEntity)) ||
+      ((header->frame_size_ != 0) &&
+       !fits_(ring, header->frame_offset_, header->frame_size_,
+              sizeof(ShmFrame)))) {
+    close_(ring);
+
+    return false;
+  }  // fi
+
+  return true;
+}  // attach_()
+
+/**
+ *  Unmap the object; its writer also removes the name, readers that
+ *  still map it keep their mapping.
+ *
+ *  @since  0.1.0
+ **/
+void close_(ShmRing *ring) {
+  if (ring->header_ == (ShmHeader *)NULL) {
+    return;
+  }  // fi
+
+#ifndef _WIN32
+  munmap((void *)ring->header_, ring->size_);
+
+  if (ring->owner_) {
+    shm_unlink(ring->name_);
+  }  // fi
+#endif
+
+  ring->header_ = (ShmHeader *)NULL;
+  ring->size_ = 0;
+}  // close_()
+
+/**
+ *  Publish the world after a tick into the next state slot: the ship,
+ *  the visible meteors, then the live lasers.  Called by the thread
+ *  that steps the world only.
+ *
+ *  @param ShmRing * the writer's mapping.
+ *  @param World const * the world.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void publish_(ShmRing *ring, World const *world) {
+  extern LaserAllocator laser_allocator;
+
+  ShmHeader *header = ring->header_;
+  MeteorStore const *meteors = &world->scene_.meteors_;
+  LaserPool const *pool = &world->scene_.lasers_;
+  Wings const *wings = &world->wings_;
+
+  int const generation = SDL_AtomicGet(&header->state_latest_) + 1;
+  uint32_t const max = header->max_entities_;
+
+  ShmState *state = (ShmState *)slot_(header, header->state_offset_,
+                                      header->state_size_, generation);
+  ShmEntity *entity = (ShmEntity *)(state + 1);
+
+  uint32_t count = 0;
+
+  write_begin_(&state->seq_);
+
+  state->tick_ = world->tick_;
+  state->ship_x_ = wings->position_.x;
+  state->ship_y_ = wings->position_.y;
+  state->health_ = wings->health;
+  state->lives_ = wings->num_life;
+  state->alive_ = wings->alive ? 1 : 0;
+
+  for (int i = 0; (i < meteors->count_) && (count < max); ++i) {
+    if (meteors->flags_[i] & METEOR_VISIBLE) {
+      entity->x_ = meteors->x_[i];
+      entity->y_ = meteors->y_[i];
+      entity->w_ = meteors->w_[i];
+      entity->h_ = meteors->h_[i];
+      entity->vx_ = meteors->vx_[i];
+      entity->vy_ = meteors->vy_[i];
+      entity->kind_ = meteors->sprite_[i];
+      entity->flags_ = 0;
+      entity->reserved_ = 0;
+
+      entity += 1;
+      count += 1;
+    }  // fi
+  }    // od
+
+  state->meteor_count_ = count;
+
+  for (int j = 0; (j < pool->count_) && (count < max); ++j) {
+    Laser const *laser = laser_allocator.at(pool, j);
+
+    entity->x_ = laser->box_.x;
+    entity->y_ = laser->box_.y;
+    entity->w_ = laser->box_.w;
+    entity->h_ = laser->box_.h;
+    entity->vx_ = 0;
+    entity->vy_ = -laser->velocity_;
+    entity->kind_ = (uint8_t)laser->frame_;
+    entity->flags_ = SHM_LASER;
+    entity->reserved_ = 0;
+
+    entity += 1;
+    count += 1;
+  }  // od
+
+  state->laser_count_ = count - state->meteor_count_;
+
+  write_end_(&state->seq_);
+
+  SDL_AtomicSet(&header->state_latest_, generation);
+}  // publish_()
+
+/**
+ *  Start writing the next frame slot; the caller renders or copies
+ *  the frame straight into the returned pixels, then calls
+ *  frame_end().  Called by the renderer thread only.
+ *
+ *  @param ShmRing * the writer's mapping.
+ *  @param int * the width of the frame.
+ *  @param int * the height of the frame.
+ *  @param int * the pitch (bytes per row) of the pixels.
+ *  @return void * the pixels, NULL if frames are not exported.
+ *  @since  0.1.0
+ **/
+void *frame_begin_(ShmRing *ring, int *w, int *h, int *pitch) {
+  ShmHeader *header = ring->header_;
+  ShmFrame *frame = (ShmFrame *)NULL;
+
+  if (header->frame_size_ == 0) {
+    return (void *)NULL;
+  }  // fi
+
+  frame = (ShmFrame *)slot_(header, header->frame_offset_,
+                            header->frame_size_,
+                            SDL_AtomicGet(&header->frame_latest_) + 1);
+
+  write_begin_(&frame->seq_);
+
+  *w = frame->w_;
+  *h = frame->h_;
+  *pitch = frame->pitch_;
+
+  return (void *)(frame + 1);
+}  // frame_begin_()
+
+/**
+ *  Finish the frame started by frame_begin() and publish it.
+ *
+ *  @param ShmRing * the writer's mapping.
+ *  @param uint32_t the tick the frame shows.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void frame_end_(ShmRing *ring, uint32_t tick) {
+  ShmHeader *header = ring->header_;
+
+  int const generation = SDL_AtomicGet(&header->frame_latest_) + 1;
+
+  ShmFrame *frame = (ShmFrame *)slot_(header, header->frame_offset_,
+                                      header->frame_size_, generation);
+
+  frame->tick_ = tick;
+
+  write_end_(&frame->seq_);
+
+  SDL_AtomicSet(&header->frame_latest_, generation);
+}  // frame_end_()
+
+/**
+ *  The newest state, read in place.  Once done with it, the reader
+ *  checks valid(&state->seq_, seq); if false, the writer has reused
+ *  the slot meanwhile and the state must be read again.
+ *
+ *  @param ShmRing const * the reader's mapping.
+ *  @param int * the slot's sequence number, for valid().
+ *  @return ShmState const * the state, NULL if none is published yet.
+ *  @since  0.1.0
+ **/
+ShmState const *state_(ShmRing const *ring, int *seq) {
+  ShmHeader *header = ring->header_;
+  ShmState const *state = (ShmState const *)NULL;
+
+  int generation = SDL_AtomicGet(&header->state_latest_);
+
+  if (generation == 0) {
+    return (ShmState const *)NULL;
+  }  // fi
+
+  state = (ShmState const *)slot_(header, header->state_offset_,
+                                  header->state_size_, generation);
+  *seq = read_begin_(&state->seq_);
+
+  return state;
+}  // state_()
+
+/**
+ *  The newest frame, read in place; see state().
+ *
+ *  @return ShmFrame const * the frame, NULL if none is published yet.
+ *  @since  0.1.0
+ **/
+ShmFrame const *frame_(ShmRing const *ring, int *seq) {
+  ShmHeader *header = ring->header_;
+  ShmFrame const *frame = (ShmFrame const *)NULL;
+
+  int generation = SDL_AtomicGet(&header->frame_latest_);
+
+  if ((header->frame_size_ == 0) || (generation == 0)) {
+    return (ShmFrame const *)NULL;
+  }  // fi
+
+  frame = (ShmFrame const *)slot_(header, header->frame_offset_,
+                                  header->frame_size_, generation);
+  *seq = read_begin_(&frame->seq_);
+
+  return frame;
+}  // frame_()
+
+/**
+ *  Whether what was read from a slot since state() or frame() is
+ *  whole: the slot was not being written when the read began, and has
+ *  not been written since.
+ *
+ *  @param SDL_atomic_t const * the slot's seq_.
+ *  @param int the sequence number state() or frame() returned.
+ *  @return bool true if the read is good.
+ *  @since  0.1.0
+ **/
+bool valid_(SDL_atomic_t const *seq, int begun) {
+  // 讀完資料之後才讀 seq_
+  SDL_MemoryBarrierAcquire();
+
+  return ((begun & 1) == 0) && (SDL_AtomicGet((SDL_atomic_t *)seq) == begun);
+}  // valid_()
+
+/**
+ *  The entities of a state: meteor_count_ meteors, then laser_count_
+ *  lasers.
+ *
+ *  @since  0.1.0
+ **/
+ShmEntity const *entities_(ShmState const *state) {
+  return (ShmEntity const *)(state + 1);
+}  // entities_()
+
+/**
+ *  Create the shared memory object with `size` bytes, or with `size`
+ *  0 open the existing one read-only, and map all of it.  There is no
+ *  POSIX shared memory on Windows, which never exports.
+ *
+ *  @since  0.1.0
+ **/
+bool map_(ShmRing *ring, char const *name, size_t size) {
+  // shm_open() 的名稱須以 "/" 開頭
+  snprintf(ring->name_, sizeof(ring->name_), "%s%s",
+           (name[0] == '/') ? "" : "/", name);
+
+  ring->header_ = (ShmHeader *)NULL;
+  ring->size_ = 0;
+
+#ifdef _WIN32
+  (void)size;
+
+  return false;
+#else
+  bool const create = (size > 0);
+  int fd = -1;
+  void *base = MAP_FAILED;
+  struct stat info;
+
+  fd = create ? shm_open(ring->name_, O_RDWR | O_CREAT | O_TRUNC, 0644)
+              : shm_open(ring->name_, O_RDONLY, 0);
+
+  if (fd < 0) {
+    return false;
+  }  // fi
+
+  if (create) {
+    if (ftruncate(fd, (off_t)size) != 0) {
+      close(fd);
+
+      return false;
+    }  // fi
+  }    // fi
+  else if ((fstat(fd, &info) == 0) &&
+           ((size_t)info.st_size >= sizeof(ShmHeader))) {
+    size = (size_t)info.st_size;
+  }  // fi
+  else {
+    close(fd);
+
+    return false;
+  }  // esle
+
+  base = mmap((void *)NULL, size,
+              create ? (PROT_READ | PROT_WRITE) : PROT_READ,
+              MAP_SHARED, fd, 0);
+
+  // mapping 建立後即可關閉 fd
+  close(fd);
+
+  if (base == MAP_FAILED) {
+    return false;
+  }  // fi
+
+  ring->header_ = (ShmHeader *)base;
+  ring->size_ = size;
+
+  return true;
+#endif
+}  // map_()
+
+/**
+ *  The slot of `generation` in the ring at `offset`.
+ *
+ *  @since  0.1.0
+ **/
+uint8_t *slot_(ShmHeader const *header, uint64_t offset, uint32_t size,
+               int generation) {
+  return (uint8_t *)header + offset +
+         (size_t)size * ((uint32_t)generation % header->slots_);
+}  // slot_()
+
+/**
+ *  Whether a ring of the header's slots_, `size` bytes each and at
+ *  least `least` bytes, lies at `offset` past the header and inside
+ *  the mapping.
+ *
+ *  @since  0.1.0
+ **/
+bool fits_(ShmRing const *ring, uint64_t offset, uint64_t size,
+           uint64_t least) {
+  return (size >= least) && (offset >= sizeof(ShmHeader)) &&
+         (offset <= ring->size_) &&
+         (size * ring->header_->slots_ <= ring->size_ - offset);
+}  // fits_()
+
+/**
+ *  Make seq_ odd, before anything of the slot is written.
+ *
+ *  @since  0.1.0
+ **/
+void write_begin_(SDL_atomic_t *seq) {
+  SDL_AtomicSet(seq, SDL_AtomicGet(seq) + 1);
+  SDL_MemoryBarrierRelease();
+}  // write_begin_()
+
+/**
+ *  Make seq_ even again, after all of the slot is written.
+ *
+ *  @since  0.1.0
+ **/
+void write_end_(SDL_atomic_t *seq) {
+  SDL_MemoryBarrierRelease();
+  SDL_AtomicSet(seq, SDL_AtomicGet(seq) + 1);
+}  // write_end_()
+
+/**
+ *  Read seq_ before anything of the slot is read.
+ *
+ *  @since  0.1.0
+ **/
+int read_begin_(SDL_atomic_t const *seq) {
+  int begun = SDL_AtomicGet((SDL_atomic_t *)seq);
+
+  SDL_MemoryBarrierAcquire();
+
+  return begun;
+}  // read_begin_()
+
+/**
+ *  Round a size up to SHM_ALIGN.
+ *
+ *  @since  0.1.0
+ **/
+size_t align_(size_t size) {
+  return (size + SHM_ALIGN - 1) / SHM_ALIGN * SHM_ALIGN;
+}  // align_()
+
+// shm.c
@@ -0,0 +1,966 @@
+/**
+ *  @file       sim.c
+ *  @brief      Defines the simulation of the world.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The simulation.  One tick moves the ship by the input, fires, moves
+ *  the lasers and the meteors, respawns the meteors which left the
+ *  scene, and resolves the collisions.  Only the world's own dice stream
+ *  is rolled, so worlds can be stepped on different threads.
+ **/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "laser.h"
+#include "sim.h"
+
+// 分工用的大小
+#define METEOR_CHUNK 1024  // 每段隕石數, 剔除結果依段合併
+#define LASER_GRAIN 64     // 每個工作的 laser 數
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static void init_(World *, WorldConfig const *, WorldHooks const *);
+static void release_(World *);
+static void reset_(World *, uint64_t);
+static void step_(World *, Input const *);
+static void pilot_(World const *, Input *);
+static uint32_t hash_(World const *);
+
+static void init_meteors_(World *, bool);
+static void init_wings_(World *);
+static void center_wings_(World *);
+static void init_laser_(World *, int);
+static Laser *laser_at_(LaserPool const *, int);
+static void meteor_box_(MeteorStore const *, int, Rect *);
+
+static void parallel_for_(World *, int, int, SimRange);
+static void event_(World const *, char const *, int32_t);
+static void phase_(World const *, SimPhase, bool);
+
+static void update_lasers_(World *);
+static void update_laser_range_(void *, int, int, int);
+static void update_meteors_(World *);
+static void update_meteor_range_(void *, int, int, int);
+static void collide_lasers_(World *);
+static void collide_laser_range_(void *, int, int, int);
+static void collide_wings_(World *);
+
+static uint32_t mix_(uint32_t, uint32_t);
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global Simulator object.
+ *
+ *  @since  0.1.0
+ **/
+Simulator simulator = {
+    init_, release_, reset_, step_, pilot_, hash_,
+};  // simulator
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Make a world: the scene of `config`, its meteors and the ship at
+ *  its start position.  The world allocates its storage here once;
+ *  stepping it does not allocate.
+ *
+ *  @param World * the world to initialize.
+ *  @param WorldConfig const * what to make it from.
+ *  @param WorldHooks const * the host's hooks, or NULL for none.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void init_(World *world, WorldConfig const *config, WorldHooks const *hooks) {
+  extern Dice dice;
+  extern GridIndex grid_index;
+  extern LaserAllocator laser_allocator;
+
+  Scene *scene = &world->scene_;
+
+  int meteors = 0;
+  int lasers = 0;
+  int cell_w = 0;
+  int cell_h = 0;
+
+  if ((config->kinds_ < 1) || (config->kinds_ > SIM_METEOR_KINDS)) {
+    printf("World Error: %d kinds of meteors, 1 .. %d expected\n",
+           config->kinds_, SIM_METEOR_KINDS);
+    exit(-1);
+  }  // fi
+
+  world->tick_ = 0;
+  world->config_ = *config;
+
+  memset(&world->hooks_, 0, sizeof(WorldHooks));
+
+  if (hooks != (WorldHooks const *)NULL) {
+    world->hooks_ = *hooks;
+  }  // fi
+
+  // 沒有 parallel_for 時, 所有工作都在呼叫的執行緒上做
+  if ((world->hooks_.parallel_for == NULL) || (world->hooks_.workers < 1)) {
+    world->hooks_.parallel_for = NULL;
+    world->hooks_.workers = 1;
+  }  // fi
+
+  dice.seed_with(&world->dice_, config->seed_);
+
+  scene->box_.x = 0;
+  scene->box_.y = 0;
+  scene->box_.w = config->width_;
+  scene->box_.h = config->height_;
+  scene->sprite_counts_ = config->kinds_;
+
+  // stress 模式可放大 laser pool
+  laser_allocator.init(&scene->lasers_, (config->lasers_ > 0)
+                                            ? config->lasers_
+                                            : LASER_POOL_CAPACITY);
+
+  init_meteors_(world, true);
+  init_wings_(world);
+
+  // 碰撞偵測用的格子: 隕石生成格子的一半, 但不小於隕石的平均大小;
+  // 隕石很密時格子跟著縮小, 候選數才會接近真正重疊的數量
+  for (int k = 0; k < config->kinds_; ++k) {
+    cell_w += config->meteor_shapes_[k].w_;
+    cell_h += config->meteor_shapes_[k].h_;
+  }  // od
+
+  cell_w /= config->kinds_;
+  cell_h /= config->kinds_;
+
+  cell_w = (scene->cell_.x / 2 > cell_w) ? scene->cell_.x / 2 : cell_w;
+  cell_h = (scene->cell_.y / 2 > cell_h) ? scene->cell_.y / 2 : cell_h;
+
+  grid_index.init(&scene->grid_, config->width_, config->height_,
+                  (cell_w > 1) ? cell_w : 1, (cell_h > 1) ? cell_h : 1);
+
+  // 平行更新與碰撞偵測用的暫存區
+  meteors = scene->meteors_.count_;
+  lasers = scene->lasers_.capacity_;
+
+  world->tally_ = (int32_t *)malloc(
+      sizeof(int32_t) * ((meteors + METEOR_CHUNK - 1) / METEOR_CHUNK + 1));
+  world->hit_ = (int32_t *)malloc(sizeof(int32_t) * lasers);
+  world->toi_ = (float *)malloc(sizeof(float) * lasers);
+
+  for (int w = 0; w < world->hooks_.workers; ++w) {
+    grid_index.marks_init(&world->marks_[w]);
+    world->candidates_[w] = (int32_t *)malloc(sizeof(int32_t) * meteors);
+  }  // od
+}  // init_()
+
+/**
+ *  Free the storage of a world.
+ *
+ *  @since  0.1.0
+ **/
+void release_(World *world) {
+  extern GridIndex grid_index;
+  extern LaserAllocator laser_allocator;
+  extern MeteorKernel meteor_kernel;
+
+  for (int w = 0; w < world->hooks_.workers; ++w) {
+    grid_index.marks_release(&world->marks_[w]);
+    free(world->candidates_[w]);
+  }  // od
+
+  free(world->tally_);
+  free(world->hit_);
+  free(world->toi_);
+
+  meteor_kernel.release(&world->scene_.meteors_);
+  laser_allocator.release(&world->scene_.lasers_);
+  grid_index.release(&world->scene_.grid_);
+}  // release_()
+
+/**
+ *  Start the world over from `seed`, reusing its storage: the world
+ *  is then the one init() makes from its config with that seed.
+ *
+ *  @param World * the world.
+ *  @param uint64_t the new seed.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void reset_(World *world, uint64_t seed) {
+  extern Dice dice;
+  extern LaserAllocator laser_allocator;
+
+  world->tick_ = 0;
+  world->config_.seed_ = seed;
+
+  dice.seed_with(&world->dice_, seed);
+  laser_allocator.clear(&world->scene_.lasers_);
+
+  init_meteors_(world, false);
+  init_wings_(world);
+}  // reset_()
+
+/**
+ *  Advance the world by one fixed tick.  The game time is
+ *  `tick_ * TICK_INTERVAL` ms, so the result does not depend on how
+ *  often, or how fast, the world is stepped.
+ *
+ *  @param World * the world.
+ *  @param Input const * the player's input for this tick.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void step_(World *world, Input const *input) {
+  WorldConfig const *config = &world->config_;
+  Wings *wings = &world->wings_;
+
+  uint32_t now = world->tick_ * TICK_INTERVAL;
+
+  world->kills_ = 0;
+  world->damage_ = 0;
+
+  wings->last_position_ = wings->position_;
+
+  if (input->up_) {
+    wings->position_.y -= WINGS_STEP;
+  }
+  if (input->down_) {
+    wings->position_.y += WINGS_STEP;
+  }
+  if (input->left_) {
+    wings->position_.x -= WINGS_STEP;
+  }
+  if (input->right_) {
+    wings->position_.x += WINGS_STEP;
+  }
+  if (input->fire_) {
+    if (config->fire_rate_ > 0) {
+      // 每秒 fire_rate_ 發, 平均分到各個 tick, 一個 tick 可能齊射數發
+      uint64_t const rate = (uint64_t)config->fire_rate_ * TICK_INTERVAL;
+      uint64_t const tick = world->tick_;
+      int shots = (int)(((tick + 1) * rate) / 1000 - (tick * rate) / 1000);
+
+      for (int k = 0; k < shots; ++k) {
+        init_laser_(world, k - shots / 2);
+      }  // od
+    }  // fi
+    else if (wings->shot_laser_next_time <= now) {
+      init_laser_(world, 0);
+      wings->shot_laser_next_time = now + 400;
+    }  // fi
+  }
+  phase_(world, SIM_UPDATE_LASERS, true);
+  update_lasers_(world);  // 移動 lasers 的位置
+  phase_(world, SIM_UPDATE_LASERS, false);
+
+  phase_(world, SIM_UPDATE_METEORS, true);
+  update_meteors_(world);  // 捲動 meteors 的位置
+  phase_(world, SIM_UPDATE_METEORS, false);
+
+  phase_(world, SIM_COLLIDE_LASERS, true);
+  collide_lasers_(world);
+  phase_(world, SIM_COLLIDE_LASERS, false);
+
+  phase_(world, SIM_COLLIDE_WINGS, true);
+  collide_wings_(world);
+  phase_(world, SIM_COLLIDE_WINGS, false);
+
+  world->tick_ += 1;
+}  // step_()
+
+/**
+ *  The stress mode's pilot: fly the ship along a Lissajous figure
+ *  over most of the scene, firing all the time.  Only the movement
+ *  and fire of `input` are set.
+ *
+ *  @param World const * the world.
+ *  @param Input * the input to fill in.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void pilot_(World const *world, Input *input) {
+  Rect const *box = &world->scene_.box_;
+  Shape const *ship = &world->config_.ship_;
+  Wings const *wings = &world->wings_;
+
+  float t = (float)world->tick_ * TICK_INTERVAL / 1000.0f;  // 秒
+  int x = (box->w - ship->w_) / 2 + (int)(box->w * 0.4f * sinf(t * 0.7f));
+  int y = (box->h - ship->h_) / 2 + (int)(box->h * 0.3f * sinf(t * 1.1f));
+
+  // 朝目標點移動, 一個 tick 的步距 (WINGS_STEP) 內就不動
+  input->left_ = wings->position_.x > x + 5;
+  input->right_ = wings->position_.x < x - 5;
+  input->up_ = wings->position_.y > y + 5;
+  input->down_ = wings->position_.y < y - 5;
+  input->fire_ = true;
+}  // pilot_()
+
+/**
+ *  FNV-1a style hash of the world after a tick: the tick, the ship,
+ *  every meteor and every laser.  Two runs that agree on every tick's
+ *  hash played the same game.
+ *
+ *  @return uint32_t the hash.
+ *  @since  0.1.0
+ **/
+uint32_t hash_(World const *world) {
+  Wings const *wings = &world->wings_;
+  MeteorStore const *meteors = &world->scene_.meteors_;
+  LaserPool const *pool = &world->scene_.lasers_;
+  Laser const *laser = (Laser const *)NULL;
+
+  uint32_t hash = 2166136261u;
+
+  hash = mix_(hash, world->tick_);
+  hash = mix_(hash, wings->position_.x);
+  hash = mix_(hash, wings->position_.y);
+  hash = mix_(hash, wings->health);
+  hash = mix_(hash, wings->num_life);
+
+  for (int i = 0; i < meteors->count_; ++i) {
+    hash = mix_(hash, meteors->x_[i]);
+    hash = mix_(hash, meteors->y_[i]);
+    hash = mix_(hash, meteors->vx_[i]);
+    hash = mix_(hash, meteors->vy_[i]);
+    hash = mix_(hash, meteors->flags_[i] | (meteors->sprite_[i] << 8));
+  }  // od
+
+  hash = mix_(hash, pool->count_);
+
+  for (int i = 0; i < pool->count_; ++i) {
+    laser = laser_at_(pool, i);
+
+    hash = mix_(hash, laser->box_.x);
+    hash = mix_(hash, laser->box_.y);
+    hash = mix_(hash, laser->exploding_idx);
+  }  // od
+
+  return hash;
+}  // hash_()
+
+/**
+ *  Initialize the array of meteors.
+ *
+ *  @param World * the world to which these meteors belong.
+ *  @param bool allocate the store; false when a reset reuses it.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void init_meteors_(World *world, bool allocate) {
+  extern Dice dice;
+  extern MeteorKernel meteor_kernel;
+
+  WorldConfig const *config = &world->config_;
+  Scene *scene = &world->scene_;
+  DiceStream *stream = &world->dice_;
+
+  int rows = 0;
+  int cols = 0;
+  int count = 0;
+
+  uint32_t *rolls = (uint32_t *)NULL;
+  MeteorStore *meteors = &scene->meteors_;
+
+  // 將畫面劃分成大小為 256 * 192 的格子
+  // 每個格子有一個隕石
+  scene->cell_.x = 256;
+  scene->cell_.y = 192;
+
+  cols = (scene->box_.w / scene->cell_.x > 1) ? scene->box_.w / scene->cell_.x
+                                              : 1;
+  rows = (scene->box_.h / scene->cell_.y > 1) ? scene->box_.h / scene->cell_.y
+                                              : 1;
+  count = rows * cols;
+
+  // 指定隕石數時, 依數量等比例縮放格子
+  if (config->meteors_ > 0) {
+    double scale = sqrt((double)scene->box_.w * scene->box_.h /
+                        (256.0 * 192.0 * config->meteors_));
+
+    scene->cell_.x = ((int)(256 * scale) > 2) ? (int)(256 * scale) : 2;
+    scene->cell_.y = ((int)(192 * scale) > 2) ? (int)(192 * scale) : 2;
+
+    cols = (scene->box_.w / scene->cell_.x > 1)
+               ? scene->box_.w / scene->cell_.x
+               : 1;
+    count = config->meteors_;
+  }  // fi
+
+  scene->obj_counts_ = count;
+
+  if (allocate) {
+    meteor_kernel.alloc(meteors, count);
+  }  // fi
+
+  // 整批隕石的每個欄位一次擲完, 暫存於尚未使用的 culled_
+  rolls = (uint32_t *)meteors->culled_;
+
+  dice.fill_with(stream, scene->sprite_counts_, rolls, count);
+
+  for (int i = 0; i < count; ++i) {
+    Shape const *shape = &config->meteor_shapes_[rolls[i]];
+
+    meteors->sprite_[i] = (uint8_t)rolls[i];
+    meteors->w_[i] = shape->w_;
+    meteors->h_[i] = shape->h_;
+  }  // od
+
+  dice.fill_with(stream, 5, (uint32_t *)meteors->vy_, count);
+  dice.fill_with(stream, 3, (uint32_t *)meteors->vx_, count);
+  dice.fill_with(stream, 2, rolls, count);  // 往左或往右
+
+  for (int i = 0; i < count; ++i) {
+    meteors->vy_[i] += 1;
+    meteors->vx_[i] += 1;
+    if (rolls[i] == 0) {
+      meteors->vx_[i] = -meteors->vx_[i];
+    }
+  }  // od
+
+  // 設定隕石的位置, 在格子的左上四分之一內
+  dice.fill_with(stream, scene->cell_.x / 2, (uint32_t *)meteors->x_, count);
+  dice.fill_with(stream, scene->cell_.y / 2, (uint32_t *)meteors->y_, count);
+  dice.fill_with(stream, 2, rolls, count);  // 是否可見
+
+  for (int i = 0; i < count; ++i) {
+    meteors->x_[i] += (i % cols) * scene->cell_.x;
+    meteors->y_[i] += (i / cols) * scene->cell_.y;
+
+    if (rolls[i] == 1) {
+      meteors->flags_[i] = METEOR_VISIBLE;
+    }  // fi
+    else {
+      meteors->flags_[i] = 0;
+    }  // esle
+  }    // od
+}  // init_meteors_()
+
+/**
+ *  Give the ship its full health and lives, at its start position.
+ *
+ *  @since  0.1.0
+ **/
+void init_wings_(World *world) {
+  Wings *wings = &world->wings_;
+
+  wings->alive = true;
+  wings->health = 100;
+  wings->num_life = 3;
+  wings->shot_laser_next_time = 0;
+
+  world->kills_ = 0;
+  world->damage_ = 0;
+
+  center_wings_(world);
+}  // init_wings_()
+
+/**
+ *  Move the ship to its start position, below the middle of the
+ *  scene.
+ *
+ *  @since  0.1.0
+ **/
+void center_wings_(World *world) {
+  Shape const *ship = &world->config_.ship_;
+  Wings *wings = &world->wings_;
+
+  wings->position_.x = ((world->scene_.box_.w - ship->w_) / 2);
+  wings->position_.y = ((world->scene_.box_.h / 2) + ship->h_);
+  wings->last_position_ = wings->position_;  // 不內插重生的瞬移
+}  // center_wings_()
+
+/**
+ *  Fire a laser from the ship.
+ *
+ *  @param World * the world.
+ *  @param int how many laser widths to the side of the ship the laser
+ *         starts, for volleys of several lasers per tick.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void init_laser_(World *world, int spread) {
+  extern LaserAllocator laser_allocator;
+
+  Scene *scene = &world->scene_;
+  Wings const *wings = &world->wings_;
+  Shape const *shape = &world->config_.laser_;
+  Laser *laser = laser_allocator.alloc(&scene->lasers_);
+
+  // pool 已滿, 這一發不射出
+  if (laser == (Laser *)NULL) {
+    event_(world, "laser_pool_full", scene->lasers_.count_);
+
+    return;
+  }  // fi
+
+  event_(world, "laser_spawn", scene->lasers_.count_);
+
+  laser->idx = 0;
+  laser->frame_ = 0;
+
+  // 設定雷射的位置在飛機的位置
+  laser->box_.x =
+      wings->position_.x + ((world->config_.ship_.w_ - shape->w_) / 2);
+  laser->box_.y = wings->position_.y - shape->h_;
+  laser->box_.w = shape->w_;
+  laser->box_.h = shape->h_;
+
+  // 齊射: 向兩側排開, 超出畫面的繞回另一側
+  if (spread != 0) {
+    int width = scene->box_.w;
+
+    laser->box_.x += spread * laser->box_.w;
+    laser->box_.x = ((laser->box_.x % width) + width) % width;
+  }  // fi
+
+  laser->velocity_ = 5;
+  laser->visible_ = true;
+  laser->body_enable = true;
+  laser->exploding = false;
+  laser->exploding_idx = 7;
+}  // init_laser_()
+
+/**
+ *  Return the i-th live laser of the pool.
+ *
+ *  @since  0.1.0
+ **/
+Laser *laser_at_(LaserPool const *pool, int i) {
+  return &pool->slots_[pool->index_[i]];
+}  // laser_at_()
+
+/**
+ *  Gather the i-th meteor's bounding box into a Rect.
+ *
+ *  @since  0.1.0
+ **/
+void meteor_box_(MeteorStore const *meteors, int i, Rect *box) {
+  box->x = meteors->x_[i];
+  box->y = meteors->y_[i];
+  box->w = meteors->w_[i];
+  box->h = meteors->h_[i];
+}  // meteor_box_()
+
+/**
+ *  Run `body` over [0, count) with the host's parallel_for, or on
+ *  this thread as worker 0.
+ *
+ *  @since  0.1.0
+ **/
+void parallel_for_(World *world, int count, int grain, SimRange body) {
+  if (world->hooks_.parallel_for != NULL) {
+    world->hooks_.parallel_for(count, grain, body, (void *)world);
+  }  // fi
+  else if (count > 0) {
+    body((void *)world, 0, count, 0);
+  }  // esle
+}  // parallel_for_()
+
+/**
+ *  Tell the host about a gameplay event.
+ *
+ *  @since  0.1.0
+ **/
+void event_(World const *world, char const *name, int32_t value) {
+  if (world->hooks_.event != NULL) {
+    world->hooks_.event(name, value);
+  }  // fi
+}  // event_()
+
+/**
+ *  Tell the host a phase of the tick begins or ends.
+ *
+ *  @since  0.1.0
+ **/
+void phase_(World const *world, SimPhase phase, bool begin) {
+  if (world->hooks_.phase != NULL) {
+    world->hooks_.phase(phase, begin, world->tick_);
+  }  // fi
+}  // phase_()
+
+/**
+ *  Update lasers' position.  Lasers move and animate in parallel;
+ *  the spent ones are then removed in pool order.
+ *
+ *  @since  0.1.0
+ **/
+void update_lasers_(World *world) {
+  extern LaserAllocator laser_allocator;
+
+  Laser *laser = (Laser *)NULL;
+  LaserPool *pool = &world->scene_.lasers_;
+
+  int i = 0;
+
+  parallel_for_(world, pool->count_, LASER_GRAIN, update_laser_range_);
+
+  while (i < pool->count_) {
+    laser = laser_at_(pool, i);
+
+    // 移除後, 最後一個 laser 會被換到位置 i, 所以 i 不遞增
+    if (laser->box_.y < 0 || laser->exploding_idx >= LASER_FRAMES) {
+      event_(world, "laser_destroy", pool->index_[i]);
+      laser_allocator.destroy(pool, i);
+    }  // fi
+    else {
+      ++i;
+    }  // esle
+  }    // od
+}  // update_lasers_()
+
+/**
+ *  Move and animate the lasers [begin, end) of the pool.
+ *
+ *  @param void * the World.
+ *  @since  0.1.0
+ **/
+void update_laser_range_(void *context, int begin, int end, int worker) {
+  Laser *laser = (Laser *)NULL;
+  LaserPool *pool = &((World *)context)->scene_.lasers_;
+
+  (void)worker;
+
+  for (int i = begin; i < end; ++i) {
+    laser = laser_at_(pool, i);
+
+    if (laser->exploding) {
+      if (laser->exploding_idx < LASER_FRAMES) {
+        laser->frame_ = laser->exploding_idx;
+      }
+      laser->exploding_idx = laser->exploding_idx + 1;
+    } else {
+      laser->idx = (laser->idx + 1) % 7;
+      laser->frame_ = laser->idx;
+    }
+
+    laser->box_.y -= laser->velocity_;
+  }  // od
+}  // update_laser_range_()
+
+/**
+ *  Update meteors' position.
+ *
+ *  @since  0.1.0
+ **/
+void update_meteors_(World *world) {
+  extern Dice dice;
+  extern GridIndex grid_index;
+
+  Scene *scene = &world->scene_;
+  MeteorStore *meteors = &scene->meteors_;
+  DiceStream *stream = &world->dice_;
+  Shape const *shape = (Shape const *)NULL;
+
+  int chunks = (meteors->count_ + METEOR_CHUNK - 1) / METEOR_CHUNK;
+  int culls = 0;
+
+  // 分段平行 (並向量化) 移動所有隕石, 並找出離開畫面者
+  parallel_for_(world, chunks, 1, update_meteor_range_);
+
+  // 依段的順序合併剔除結果, 與執行緒數無關
+  for (int k = 0; k < chunks; ++k) {
+    memmove(meteors->culled_ + culls, meteors->culled_ + k * METEOR_CHUNK,
+            sizeof(int32_t) * world->tally_[k]);
+    culls += world->tally_[k];
+  }  // od
+
+  // 重生 (respawn) 離開畫面的隕石
+  for (int k = 0; k < culls; ++k) {
+    int i = meteors->culled_[k];
+    int tmp = meteors->x_[i] / scene->cell_.x;
+
+    meteors->x_[i] =
+        dice.roll_with(stream, scene->cell_.x / 2) + tmp * scene->cell_.x;
+    meteors->vy_[i] = dice.roll_with(stream, 3) + 1;
+
+    if (dice.roll_with(stream, 2) == 0) {
+      meteors->flags_[i] |= METEOR_VISIBLE;
+      meteors->vx_[i] *= -1;
+    }  // fi
+    else {
+      meteors->flags_[i] &= ~METEOR_VISIBLE;
+    }  // esle
+
+    meteors->sprite_[i] =
+        (uint8_t)dice.roll_with(stream, scene->sprite_counts_);
+
+    // 換了造型, 外框也要跟著換, 否則遮罩會比外框小
+    shape = &world->config_.meteor_shapes_[meteors->sprite_[i]];
+    meteors->w_[i] = shape->w_;
+    meteors->h_[i] = shape->h_;
+    meteors->y_[i] = 0 - meteors->h_[i];
+  }  // od
+
+  // 重建碰撞偵測用的 grid (只收錄可見的隕石)
+  grid_index.build(&scene->grid_, meteors);
+}  // update_meteors_()
+
+/**
+ *  Integrate the meteor chunks [begin, end); chunk k holds the
+ *  meteors from k * METEOR_CHUNK on.
+ *
+ *  @param void * the World.
+ *  @since  0.1.0
+ **/
+void update_meteor_range_(void *context, int begin, int end, int worker) {
+  extern MeteorKernel meteor_kernel;
+
+  World *world = (World *)context;
+  Scene *scene = &world->scene_;
+  MeteorStore *meteors = &scene->meteors_;
+
+  (void)worker;
+
+  for (int k = begin; k < end; ++k) {
+    int first = k * METEOR_CHUNK;
+    int last = (first + METEOR_CHUNK < meteors->count_)
+                   ? first + METEOR_CHUNK
+                   : meteors->count_;
+
+    world->tally_[k] = meteor_kernel.integrate_range(
+        meteors, first, last, scene->box_.w, scene->box_.h);
+  }  // od
+}  // update_meteor_range_()
+
+/**
+ *  Check lasers against meteors with swept (continuous) collision, so
+ *  fast lasers cannot pass through small meteors within one tick.
+ *  Candidates come from the scene grid; a laser hits the meteor it
+ *  reaches first (ties go to the lowest index) and stops there.  A
+ *  meteor may absorb several lasers in the same tick.
+ *
+ *  The lasers are tested in parallel against the unchanged world, and
+ *  the hits applied afterwards in pool order, so the outcome does not
+ *  depend on the number of threads.
+ *
+ *  @since  0.1.0
+ **/
+void collide_lasers_(World *world) {
+  MeteorStore *meteors = &world->scene_.meteors_;
+  LaserPool *pool = &world->scene_.lasers_;
+  Laser *laser = (Laser *)NULL;
+
+  parallel_for_(world, pool->count_, LASER_GRAIN, collide_laser_range_);
+
+  for (int j = 0; j < pool->count_; ++j) {
+    if (world->hit_[j] >= 0) {
+      laser = laser_at_(pool, j);
+
+      // 停在撞擊點: 本 tick 起點 + 位移 * toi
+      int from = laser->box_.y + laser->velocity_;
+
+      laser->box_.y = from + (int)(-laser->velocity_ * world->toi_[j]);
+      laser->exploding = true;
+      laser->velocity_ = 0;
+      laser->body_enable = false;
+
+      // 同一 tick 數發擊中同一顆隕石, 只算一次
+      if (meteors->flags_[world->hit_[j]] & METEOR_VISIBLE) {
+        world->kills_ += 1;
+      }  // fi
+
+      meteors->flags_[world->hit_[j]] &= ~METEOR_VISIBLE;
+
+      event_(world, "laser_hit", world->hit_[j]);
+    }  // fi
+  }    // od
+}  // collide_lasers_()
+
+/**
+ *  Find the meteor each of the lasers [begin, end) reaches first,
+ *  into hit_ (-1 for none) and toi_.  Only reads the world.
+ *
+ *  @param void * the World.
+ *  @param int worker picking the per-worker grid marks and buffer.
+ *  @since  0.1.0
+ **/
+void collide_laser_range_(void *context, int begin, int end, int worker) {
+  extern Collide collide;
+  extern GridIndex grid_index;
+
+  World *world = (World *)context;
+  Scene *scene = &world->scene_;
+  MeteorStore *meteors = &scene->meteors_;
+  LaserPool *pool = &scene->lasers_;
+  Laser *laser = (Laser *)NULL;
+  Shape const *shape = (Shape const *)NULL;
+  int32_t *candidate = world->candidates_[worker];
+  Rect from;
+  Rect box;
+  Point move;
+  Point drift;
+
+  // laser 的 box_ 以雷射的 Shape 設定, 遮罩也用它的
+  Bitmask const *laser_mask = world->config_.laser_.mask_;
+
+  for (int j = begin; j < end; ++j) {
+    int hit = -1;
+    int candidates = 0;
+    float first = 2.0f;
+
+    laser = laser_at_(pool, j);
+
+    world->hit_[j] = -1;
+
+    if (!laser->body_enable) {
+      continue;
+    }  // fi
+
+    // 本 tick 開始時 laser 的位置與位移
+    from = laser->box_;
+    from.y += laser->velocity_;
+    move.x = 0;
+    move.y = -laser->velocity_;
+
+    candidates = grid_index.search(&scene->grid_, &world->marks_[worker],
+                                   from.x, laser->box_.y, from.w,
+                                   from.h + laser->velocity_, candidate);
+
+    for (int k = 0; k < candidates; ++k) {
+      int i = candidate[k];
+      float toi = 0.0f;
+
+      meteor_box_(meteors, i, &box);
+      shape = &world->config_.meteor_shapes_[meteors->sprite_[i]];
+
+      box.x -= meteors->vx_[i];
+      box.y -= meteors->vy_[i];
+      drift.x = meteors->vx_[i];
+      drift.y = meteors->vy_[i];
+
+      // 候選者依序排列, 同時撞上時保留較小的 index
+      if (collide.sweep(&from, laser_mask, &move, &box, shape->mask_,
+                        &drift, &toi) &&
+          toi < first) {
+        first = toi;
+        hit = i;
+      }  // fi
+    }    // od
+
+    world->hit_[j] = hit;
+    world->toi_[j] = first;
+  }  // od
+}  // collide_laser_range_()
+
+/**
+ *  Check if wings has been hit by some meteors.
+ *
+ *  @since  0.1.0
+ **/
+void collide_wings_(World *world) {
+  extern Collide collide;
+  extern GridIndex grid_index;
+
+  Scene *scene = &world->scene_;
+  MeteorStore *meteors = &scene->meteors_;
+  Wings *wings = &world->wings_;
+  Shape const *ship_shape = &world->config_.ship_;
+  Shape const *shape = (Shape const *)NULL;
+  Rect ship;
+  Rect box;
+  Point move;
+  Point drift;
+
+  int hits = 0;
+
+  // 本 tick 開始時戰機的位置與位移
+  ship.x = wings->last_position_.x;
+  ship.y = wings->last_position_.y;
+  ship.w = ship_shape->w_;
+  ship.h = ship_shape->h_;
+
+  move.x = wings->position_.x - ship.x;
+  move.y = wings->position_.y - ship.y;
+
+  // 先以戰機掃過的範圍從 grid 篩出候選隕石, 再逐一做連續碰撞
+  hits = grid_index.gather(
+      &scene->grid_, (move.x < 0) ? ship.x + move.x : ship.x,
+      (move.y < 0) ? ship.y + move.y : ship.y,
+      ship.w + ((move.x < 0) ? -move.x : move.x),
+      ship.h + ((move.y < 0) ? -move.y : move.y), meteors->hits_);
+
+  for (int k = 0; k < hits; ++k) {
+    int i = meteors->hits_[k];
+    float toi = 0.0f;
+
+    // 可能剛被 laser 擊中
+    if (!(meteors->flags_[i] & METEOR_VISIBLE)) {
+      continue;
+    }  // fi
+
+    meteor_box_(meteors, i, &box);
+    shape = &world->config_.meteor_shapes_[meteors->sprite_[i]];
+
+    box.x -= meteors->vx_[i];
+    box.y -= meteors->vy_[i];
+    drift.x = meteors->vx_[i];
+    drift.y = meteors->vy_[i];
+
+    if (collide.sweep(&ship, ship_shape->mask_, &move, &box, shape->mask_,
+                      &drift, &toi)) {
+      meteors->flags_[i] &= ~METEOR_VISIBLE;
+      wings->health -= 30;
+      world->damage_ += 30;
+
+      event_(world, "wings_hit", wings->health);
+
+      // stress 模式的戰機不會死, 負載才能持續
+      if (world->config_.stress_ && (wings->health <= 0)) {
+        wings->health = 100;
+      }  // fi
+
+      if (wings->health <= 0) {
+        wings->alive = false;
+        if (wings->num_life > 0) {
+          wings->alive = true;
+          wings->health = 100;
+          center_wings_(world);
+          wings->num_life -= 1;
+        }
+        break;
+      }
+    }  // fi
+  }    // od
+}  // collide_wings_()
+
+/**
+ *  Fold one 32-bit value into the state hash.
+ *
+ *  @since  0.1.0
+ **/
+uint32_t mix_(uint32_t hash, uint32_t value) {
+  return (hash ^ value) * 16777619u;
+}  // mix_()
+
+// sim.c
@@ -0,0 +1,168 @@
+/**
+ *  @file       snapshot.c
+ *  @brief      Defines the world snapshot exchange.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The snapshot file.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "snapshot.h"
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static void init_(SnapshotQueue *, int, int);
+static void release_(SnapshotQueue *);
+static Snapshot *back_(SnapshotQueue *);
+static void publish_(SnapshotQueue *);
+static Snapshot const *acquire_(SnapshotQueue *);
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global SnapshotExchange object.
+ *
+ *  @since  0.1.0
+ **/
+SnapshotExchange snapshot_exchange = {
+    init_, release_, back_, publish_, acquire_,
+};  // snapshot_exchange
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Initialize a SnapshotQueue whose snapshots hold up to `meteors`
+ *  meteors and `lasers` lasers.
+ *
+ *  @param SnapshotQueue * the queue to initialize.
+ *  @param int meteor capacity of each snapshot.
+ *  @param int laser capacity of each snapshot.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void init_(SnapshotQueue *queue, int meteors, int lasers) {
+  queue->lock_ = SDL_CreateMutex();
+
+  if (queue->lock_ == (SDL_mutex *)NULL) {
+    printf("SDL Error: %s\n", SDL_GetError());
+    exit(-1);
+  }  // fi
+
+  queue->back_ = 0;
+  queue->ready_ = 1;
+  queue->front_ = 2;
+  queue->fresh_ = false;
+
+  for (int i = 0; i < SNAPSHOT_SLOTS; ++i) {
+    Snapshot *slot = &queue->slots_[i];
+
+    slot->tick_ = 0;
+    slot->stamp_ = 0;
+    slot->alive_ = true;
+    slot->health_ = 100;
+    slot->meteor_count_ = 0;
+    slot->laser_count_ = 0;
+
+    slot->meteors_ = (Pose *)malloc(sizeof(Pose) * meteors);
+    slot->lasers_ = (Pose *)malloc(sizeof(Pose) * lasers);
+  }  // od
+}  // init_()
+
+/**
+ *  Release a SnapshotQueue.
+ *
+ *  @since  0.1.0
+ **/
+void release_(SnapshotQueue *queue) {
+  for (int i = 0; i < SNAPSHOT_SLOTS; ++i) {
+    free(queue->slots_[i].meteors_);
+    free(queue->slots_[i].lasers_);
+  }  // od
+
+  SDL_DestroyMutex(queue->lock_);
+}  // release_()
+
+/**
+ *  The slot the simulation should fill next.  Only the simulation
+ *  thread may call it.
+ *
+ *  @since  0.1.0
+ **/
+Snapshot *back_(SnapshotQueue *queue) {
+  return &queue->slots_[queue->back_];
+}  // back_()
+
+/**
+ *  Publish the back slot as the latest snapshot.  A snapshot the
+ *  renderer never picked up is simply overwritten later.
+ *
+ *  @since  0.1.0
+ **/
+void publish_(SnapshotQueue *queue) {
+  int tmp;
+
+  SDL_LockMutex(queue->lock_);
+
+  tmp = queue->ready_;
+  queue->ready_ = queue->back_;
+  queue->back_ = tmp;
+  queue->fresh_ = true;
+
+  SDL_UnlockMutex(queue->lock_);
+}  // publish_()
+
+/**
+ *  The latest published snapshot.  It stays valid, and unchanged,
+ *  until the next call.  Only the render thread may call it.
+ *
+ *  @since  0.1.0
+ **/
+Snapshot const *acquire_(SnapshotQueue *queue) {
+  int tmp;
+
+  SDL_LockMutex(queue->lock_);
+
+  if (queue->fresh_) {
+    tmp = queue->front_;
+    queue->front_ = queue->ready_;
+    queue->ready_ = tmp;
+    queue->fresh_ = false;
+  }  // fi
+
+  SDL_UnlockMutex(queue->lock_);
+
+  return &queue->slots_[queue->front_];
+}  // acquire_()
+
+// snapshot.c
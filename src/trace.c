@@ -0,0 +1,426 @@
+/**
+ *  @file       trace.c
+ *  @brief      Defines the event trace code.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The event trace file.  Does nothing until start() is called, so the
+ *  calls can stay in the code.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trace.h"
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static bool start_(char const *);
+static void thread_(char const *);
+static void begin_(char const *);
+static void end_(char const *);
+static void instant_(char const *, int32_t);
+static void stop_(void);
+
+static bool enter_(void);
+static TraceBuffer *local_buffer_(void);
+static void emit_(char const *, char, int32_t);
+static void write_string_(FILE *, char const *);
+static void close_spans_(FILE *, TraceBuffer const *, double, int);
+
+// 內部資料欄位 (private data) 宣告
+static FILE *file_ = (FILE *)NULL;  // 只有 start() 與 stop() 使用
+static Uint64 origin_ = 0;          // 記錄開始的時間
+
+static SDL_atomic_t recording_;  // 1: 記錄中, 由 start() 與 stop() 發佈
+static SDL_atomic_t writers_;    // 正在寫入 buffer 的執行緒數
+static SDL_atomic_t session_;    // 每次 stop() 加一, 舊的 local_ 即失效
+
+static TraceBuffer *buffers_[TRACE_THREADS];
+static SDL_atomic_t threads_;  // 已分配的 buffer 數
+
+static _Thread_local TraceBuffer *local_ = (TraceBuffer *)NULL;
+static _Thread_local int local_session_ = 0;
+
+// 公開 (public) 物件的宣告
+
+/**
+ *  The global Trace object.
+ *
+ *  @since  0.1.0
+ **/
+Trace trace = {
+    start_, thread_, begin_, end_, instant_, stop_,
+};  // trace
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Start recording; the trace is written to `path` by stop().
+ *
+ *  @param char const * the trace file name.
+ *  @return bool false if the file cannot be created.
+ *  @since  0.1.0
+ **/
+bool start_(char const *path) {
+  file_ = fopen(path, "w");
+
+  if (file_ == (FILE *)NULL) {
+    return false;
+  }  // fi
+
+  SDL_AtomicSet(&threads_, 0);
+  origin_ = SDL_GetPerformanceCounter();
+
+  SDL_AtomicSet(&recording_, 1);  // 以上的設定都寫好了才開始記錄
+
+  return true;
+}  // start_()
+
+/**
+ *  The calling thread's buffer, allocated on its first event.  A slot
+ *  is claimed with an atomic counter, so threads never wait on each
+ *  other.
+ *
+ *  @return TraceBuffer * NULL if there are more threads than slots.
+ *  @since  0.1.0
+ **/
+TraceBuffer *local_buffer_(void) {
+  int slot = 0;
+  int session = SDL_AtomicGet(&session_);
+
+  // 前一次記錄的 buffer 已由 stop() 釋放
+  if ((local_ != (TraceBuffer *)NULL) && (local_session_ == session)) {
+    return local_;
+  }  // fi
+
+  local_ = (TraceBuffer *)NULL;
+
+  slot = SDL_AtomicAdd(&threads_, 1);
+
+  if (slot >= TRACE_THREADS) {
+    return (TraceBuffer *)NULL;
+  }  // fi
+
+  local_ = (TraceBuffer *)malloc(sizeof(TraceBuffer));
+  local_session_ = session;
+  local_->count_ = 0;
+  local_->capacity_ = TRACE_EVENTS;
+  local_->dropped_ = 0;
+  local_->open_ = 0;
+  local_->skipped_ = 0;
+  local_->events_ = (TraceEvent *)malloc(TRACE_EVENTS * sizeof(TraceEvent));
+
+  snprintf(local_->name_, TRACE_NAME_MAX, "thread %d", slot);
+
+  buffers_[slot] = local_;
+
+  return local_;
+}  // local_buffer_()
+
+/**
+ *  Name the calling thread in the trace.
+ *
+ *  @param char const * the thread name.
+ *  @return none.
+ *  @since  0.1.0
+ **/
+void thread_(char const *name) {
+  TraceBuffer *buffer = (TraceBuffer *)NULL;
+
+  if (!enter_()) {
+    return;
+  }  // fi
+
+  buffer = local_buffer_();
+
+  if (buffer != (TraceBuffer *)NULL) {
+    snprintf(buffer->name_, TRACE_NAME_MAX, "%s", name);
+  }  // fi
+
+  SDL_AtomicAdd(&writers_, -1);
+}  // thread_()
+
+/**
+ *  Enter a write to the calling thread's buffer, if recording.  The
+ *  writer is counted first and the flag checked again, so stop()
+ *  either sees the writer and waits for it or the writer sees that
+ *  recording stopped.  A true return is paired with decrementing
+ *  `writers_`.
+ *
+ *  @return bool false if not recording.
+ *  @since  0.1.0
+ **/
+bool enter_(void) {
+  if (SDL_AtomicGet(&recording_) == 0) {
+    return false;
+  }  // fi
+
+  SDL_AtomicAdd(&writers_, 1);
+
+  if (SDL_AtomicGet(&recording_) == 0) {
+    SDL_AtomicAdd(&writers_, -1);
+
+    return false;
+  }  // fi
+
+  return true;
+}  // enter_()
+
+/**
+ *  Append an event to the calling thread's buffer.  Room is kept for
+ *  the end of every span begun, so a full buffer drops whole spans: a
+ *  begin that does not fit is dropped together with its end, and an
+ *  end is never dropped without its begin.
+ *
+ *  @since  0.1.0
+ **/
+void emit_(char const *name, char phase, int32_t value) {
+  TraceBuffer *buffer = (TraceBuffer *)NULL;
+  TraceEvent *event = (TraceEvent *)NULL;
+
+  if (!enter_()) {
+    return;
+  }  // fi
+
+  buffer = local_buffer_();
+
+  if (buffer == (TraceBuffer *)NULL) {
+    SDL_AtomicAdd(&writers_, -1);
+
+    return;
+  }  // fi
+
+  // 被丟掉的 span, 其 E 也丟掉; 記下的 span 已預留 E 的位置
+  if ((phase == 'E') && (buffer->skipped_ > 0)) {
+    buffer->skipped_ -= 1;
+    buffer->dropped_ += 1;
+    SDL_AtomicAdd(&writers_, -1);
+
+    return;
+  }  // fi
+
+  // 開始記錄之前就開始的 span, 沒有 B 可配對
+  if ((phase == 'E') && (buffer->open_ == 0)) {
+    SDL_AtomicAdd(&writers_, -1);
+
+    return;
+  }  // fi
+
+  if ((phase != 'E') &&
+      (buffer->count_ + buffer->open_ + ((phase == 'B') ? 2 : 1) >
+       TRACE_EVENTS_MAX)) {
+    buffer->skipped_ += (phase == 'B') ? 1 : 0;
+    buffer->dropped_ += 1;
+    SDL_AtomicAdd(&writers_, -1);
+
+    return;
+  }  // fi
+
+  if (buffer->count_ == buffer->capacity_) {
+    buffer->capacity_ *= 2;
+    buffer->events_ = (TraceEvent *)realloc(
+        buffer->events_, buffer->capacity_ * sizeof(TraceEvent));
+  }  // fi
+
+  buffer->open_ += (phase == 'B') ? 1 : ((phase == 'E') ? -1 : 0);
+
+  event = &buffer->events_[buffer->count_++];
+  event->name_ = name;
+  event->stamp_ = SDL_GetPerformanceCounter();
+  event->value_ = value;
+  event->phase_ = phase;
+
+  SDL_AtomicAdd(&writers_, -1);
+}  // emit_()
+
+/**
+ *  Begin a span on the calling thread.
+ *
+ *  @since  0.1.0
+ **/
+void begin_(char const *name) {
+  emit_(name, 'B', 0);
+}  // begin_()
+
+/**
+ *  End the span begun last on the calling thread.
+ *
+ *  @since  0.1.0
+ **/
+void end_(char const *name) {
+  emit_(name, 'E', 0);
+}  // end_()
+
+/**
+ *  Mark a moment on the calling thread, with a value (an index, a
+ *  health level) shown in the event's args.
+ *
+ *  @since  0.1.0
+ **/
+void instant_(char const *name, int32_t value) {
+  emit_(name, 'i', value);
+}  // instant_()
+
+/**
+ *  Write a JSON string, escaping what JSON needs escaped.
+ *
+ *  @since  0.1.0
+ **/
+void write_string_(FILE *file, char const *text) {
+  fputc('"', file);
+
+  for (; *text != '\0'; ++text) {
+    if ((*text == '"') || (*text == '\\')) {
+      fputc('\\', file);
+    }  // fi
+
+    fputc(((unsigned char)*text < 0x20) ? ' ' : *text, file);
+  }  // od
+
+  fputc('"', file);
+}  // write_string_()
+
+/**
+ *  End, at `ts`, the spans of a buffer still open when recording
+ *  stopped, innermost first, so every B written has its E.
+ *
+ *  @since  0.1.0
+ **/
+void close_spans_(FILE *file, TraceBuffer const *buffer, double ts,
+                  int tid) {
+  int ended = 0;  // 往回走時, 尚未配對的 E 數
+
+  for (int i = buffer->count_ - 1; i >= 0; --i) {
+    TraceEvent const *event = &buffer->events_[i];
+
+    if (event->phase_ == 'E') {
+      ended += 1;
+    }  // fi
+    else if ((event->phase_ == 'B') && (ended > 0)) {
+      ended -= 1;
+    }  // fi
+    else if (event->phase_ == 'B') {
+      fprintf(file, ",\n{\"name\":");
+      write_string_(file, event->name_);
+      fprintf(file, ",\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}", ts,
+              tid);
+    }  // fi
+  }    // od
+}  // close_spans_()
+
+/**
+ *  Stop recording and write every thread's events as Chrome trace
+ *  JSON, e.g. when the game ends.  Other threads may still call
+ *  begin() and end(): from here on their events are not recorded, and
+ *  the buffers are only read once the writes under way are done.
+ *
+ *  @since  0.1.0
+ **/
+void stop_(void) {
+  double const usec = 1000000.0 / (double)SDL_GetPerformanceFrequency();
+
+  FILE *file = file_;
+  Uint64 stop = SDL_GetPerformanceCounter();
+  int threads = 0;
+  int dropped = 0;
+  bool first = true;
+
+  if (file == (FILE *)NULL) {
+    return;
+  }  // fi
+
+  file_ = (FILE *)NULL;
+
+  // 之後的事件不再記錄; 等寫到一半的執行緒寫完
+  SDL_AtomicSet(&recording_, 0);
+
+  while (SDL_AtomicGet(&writers_) != 0) {
+    SDL_Delay(0);
+  }  // od
+
+  threads = SDL_min(SDL_AtomicGet(&threads_), TRACE_THREADS);
+
+  fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+  for (int t = 0; t < threads; ++t) {
+    TraceBuffer *buffer = buffers_[t];
+
+    // 執行緒名稱 (metadata event)
+    fprintf(file,
+            "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+            "\"tid\":%d,\"args\":{\"name\":",
+            first ? "" : ",\n", t + 1);
+    write_string_(file, buffer->name_);
+    fprintf(file, "}}");
+
+    first = false;
+
+    for (int i = 0; i < buffer->count_; ++i) {
+      TraceEvent const *event = &buffer->events_[i];
+
+      fprintf(file, ",\n{\"name\":");
+      write_string_(file, event->name_);
+      fprintf(file, ",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d",
+              event->phase_, (double)(event->stamp_ - origin_) * usec, t + 1);
+
+      if (event->phase_ == 'i') {
+        fprintf(file, ",\"s\":\"t\",\"args\":{\"value\":%d}", event->value_);
+      }  // fi
+
+      fprintf(file, "}");
+    }  // od
+
+    close_spans_(file, buffer, (double)(stop - origin_) * usec, t + 1);
+
+    dropped += buffer->dropped_;
+  }  // od
+
+  fprintf(file, "\n]}\n");
+  fclose(file);
+
+  if (dropped > 0) {
+    printf("Trace: %d events dropped, the buffers were full\n", dropped);
+  }  // fi
+
+  for (int t = 0; t < threads; ++t) {
+    free(buffers_[t]->events_);
+    free(buffers_[t]);
+
+    buffers_[t] = (TraceBuffer *)NULL;
+  }  // od
+
+  // 每個執行緒的 local_ 都已失效, 下次記錄時重新配置
+  SDL_AtomicAdd(&session_, 1);
+}  // stop_()
+
+// trace.c
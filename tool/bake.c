@@ -0,0 +1,205 @@
+/**
+ *  @file       bake.c
+ *  @brief      Bakes PNG images into an asset pack.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The pack baker.  Decodes the PNG files given on the command line to
+ *  RGBA32 and writes them, with a name index sorted for binary search,
+ *  into one pack file the game maps at startup (see inc/pack.h).
+ *
+ *  Usage: bake <pack> <png>...
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+#include "pack.h"
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static int by_name_(void const *, void const *);
+static uint32_t align_(uint32_t);
+static void write_pad_(FILE *, long);
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Order pack entries by name.
+ *
+ *  @since  0.1.0
+ **/
+int by_name_(void const *a, void const *b) {
+  return strcmp(((PackEntry const *)a)->name_, ((PackEntry const *)b)->name_);
+}  // by_name_()
+
+/**
+ *  Round an offset up to PACK_ALIGN.
+ *
+ *  @since  0.1.0
+ **/
+uint32_t align_(uint32_t offset) {
+  return (offset + PACK_ALIGN - 1) & ~(uint32_t)(PACK_ALIGN - 1);
+}  // align_()
+
+/**
+ *  Pad the file with zeros up to `offset`.
+ *
+ *  @since  0.1.0
+ **/
+void write_pad_(FILE *file, long offset) {
+  while (ftell(file) < offset) {
+    fputc(0, file);
+  }  // od
+}  // write_pad_()
+
+int main(int argc, char *argv[]) {
+  PackHeader header;
+  PackEntry *entries = (PackEntry *)NULL;
+  SDL_Surface **images = (SDL_Surface **)NULL;
+  FILE *file = (FILE *)NULL;
+  uint32_t offset = 0;
+  int count = argc - 2;
+
+  if (count < 1) {
+    printf("usage: %s <pack> <png>...\n", argv[0]);
+
+    return -1;
+  }  // fi
+
+  IMG_Init(IMG_INIT_PNG);
+
+  entries = (PackEntry *)calloc(count, sizeof(PackEntry));
+  images = (SDL_Surface **)calloc(count, sizeof(SDL_Surface *));
+
+  for (int i = 0; i < count; ++i) {
+    char const *name = argv[i + 2];
+    SDL_Surface *png = IMG_Load(name);
+
+    if (png == (SDL_Surface *)NULL) {
+      printf("Bake Error: %s\n", SDL_GetError());
+
+      return -1;
+    }  // fi
+
+    if (strlen(name) >= PACK_NAME_MAX) {
+      printf("Bake Error: name too long, %s\n", name);
+
+      return -1;
+    }  // fi
+
+    // 轉成 RGBA32, 與 atlas page 的格式相同
+    images[i] = SDL_ConvertSurfaceFormat(png, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(png);
+
+    if (images[i] == (SDL_Surface *)NULL) {
+      printf("Bake Error: %s\n", SDL_GetError());
+
+      return -1;
+    }  // fi
+
+    strcpy(entries[i].name_, name);
+    entries[i].width_ = (uint32_t)images[i]->w;
+    entries[i].height_ = (uint32_t)images[i]->h;
+    entries[i].offset_ = (uint32_t)i;  // 排序後用來找回圖片
+  }  // od
+
+  qsort(entries, count, sizeof(PackEntry), by_name_);
+
+  for (int i = 1; i < count; ++i) {
+    if (strcmp(entries[i - 1].name_, entries[i].name_) == 0) {
+      printf("Bake Error: %s given twice\n", entries[i].name_);
+
+      return -1;
+    }  // fi
+  }    // od
+
+  file = fopen(argv[1], "wb");
+
+  if (file == (FILE *)NULL) {
+    printf("Bake Error: cannot create %s\n", argv[1]);
+
+    return -1;
+  }  // fi
+
+  memcpy(header.magic_, PACK_MAGIC, 4);
+  header.version_ = PACK_VERSION;
+  header.count_ = (uint32_t)count;
+  header.byte_order_ = PACK_BYTE_ORDER;
+
+  // 先寫一次索引佔位, 算好位置後再回頭重寫
+  fwrite(&header, sizeof(header), 1, file);
+  fwrite(entries, sizeof(PackEntry), count, file);
+
+  offset = (uint32_t)ftell(file);
+
+  for (int i = 0; i < count; ++i) {
+    SDL_Surface *image = images[entries[i].offset_];
+
+    offset = align_(offset);
+    write_pad_(file, offset);
+
+    entries[i].offset_ = offset;
+
+    // 去掉 surface 的 pitch 補白, 一列接一列寫入
+    for (int y = 0; y < image->h; ++y) {
+      fwrite((Uint8 *)image->pixels + y * image->pitch, 4, image->w, file);
+    }  // od
+
+    offset += (uint32_t)image->w * image->h * 4;
+
+    SDL_FreeSurface(image);
+  }  // od
+
+  fseek(file, (long)sizeof(header), SEEK_SET);
+  fwrite(entries, sizeof(PackEntry), count, file);
+
+  if (fclose(file) != 0) {
+    printf("Bake Error: cannot write %s\n", argv[1]);
+
+    return -1;
+  }  // fi
+
+  printf("Baked %d images, %u bytes, into %s\n", count, offset, argv[1]);
+
+  free(images);
+  free(entries);
+
+  IMG_Quit();
+
+  return 0;
+}  // main()
+
+// bake.c
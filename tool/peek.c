@@ -0,0 +1,203 @@
+/**
+ *  @file       peek.c
+ *  @brief      Defines the shared memory reader.
+ *  @author     Yiwei Chiao <ywchiao@gmail.com>
+ *  @date       10/16/2026 created.
+ *  @date       10/16/2026 last modified.
+ *  @version    0.1.0
+ *  @section    License (The MIT License)
+ *
+ *  Copyright (c) 2015, Yiwei Chiao
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person
+ *  obtaining a copy of this software and associated documentation
+ *  files (the "Software"), to deal in the Software without
+ *  restriction, including without limitation the rights to use,
+ *  copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom
+ *  the Software is furnished to do so, subject to the following
+ *  conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ *  OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ *  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ *  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ *  OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *  @section DESCRIPTION
+ *
+ *  The shared memory reader, an example consumer of --share.  Attaches
+ *  to the object the game exports and prints the newest tick every
+ *  second: the ship, the meteors and lasers, and the frame if exported.
+ *  Everything is read in place and checked with the slot's seqlock.
+ *
+ *  Usage: peek <name> [seconds]
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <SDL2/SDL.h>
+
+#include "shm.h"
+
+#define PEEK_INTERVAL 40  // 每次讀取的間隔 (ms), 一個 tick
+
+// 內部函數 (private functions) 的前置宣告 (forward declarations)
+static bool peek_state_(ShmRing const *, int *);
+static bool peek_frame_(ShmRing const *, int *);
+
+// 函數 (方法) 的實作 (implementations)
+
+/**
+ *  Print the newest state, read again while the writer overwrites it
+ *  under the reader.
+ *
+ *  @param ShmRing const * the mapping.
+ *  @param int * count of torn reads, incremented for each.
+ *  @return bool false if no state is published yet.
+ *  @since  0.1.0
+ **/
+bool peek_state_(ShmRing const *ring, int *torn) {
+  extern ShmExport shm_export;
+
+  ShmState const *state = (ShmState const *)NULL;
+  ShmEntity const *entity = (ShmEntity const *)NULL;
+
+  int seq = 0;
+  uint32_t tick = 0;
+  int32_t ship_x = 0;
+  int32_t ship_y = 0;
+  int32_t health = 0;
+  uint32_t meteors = 0;
+  uint32_t lasers = 0;
+  int32_t lowest = INT32_MIN;  // 最低 (最接近戰機) 的隕石底邊
+
+  for (;;) {
+    state = shm_export.state(ring, &seq);
+
+    if (state == (ShmState const *)NULL) {
+      return false;
+    }  // fi
+
+    tick = state->tick_;
+    ship_x = state->ship_x_;
+    ship_y = state->ship_y_;
+    health = state->health_;
+    meteors = state->meteor_count_;
+    lasers = state->laser_count_;
+    lowest = INT32_MIN;
+
+    // 就地讀取; 數量可能來自改寫中的 slot, 先限制在容量之內
+    if (meteors > ring->header_->max_entities_) {
+      meteors = 0;
+    }  // fi
+
+    entity = shm_export.entities(state);
+
+    for (uint32_t i = 0; i < meteors; ++i) {
+      if (entity[i].y_ + entity[i].h_ > lowest) {
+        lowest = entity[i].y_ + entity[i].h_;
+      }  // fi
+    }    // od
+
+    if (shm_export.valid(&state->seq_, seq)) {
+      break;
+    }  // fi
+
+    // 讀取途中 slot 被改寫, 改讀最新的 slot
+    *torn += 1;
+  }  // od
+
+  printf("tick %u: ship (%d, %d) health %d, %u meteors (lowest %d), "
+         "%u lasers\n",
+         tick, ship_x, ship_y, health, meteors, lowest, lasers);
+
+  return true;
+}  // peek_state_()
+
+/**
+ *  Print the newest frame's tick and its center pixel; see
+ *  peek_state_().
+ *
+ *  @since  0.1.0
+ **/
+bool peek_frame_(ShmRing const *ring, int *torn) {
+  extern ShmExport shm_export;
+
+  ShmFrame const *frame = (ShmFrame const *)NULL;
+  uint8_t const *pixels = (uint8_t const *)NULL;
+
+  int seq = 0;
+  uint32_t tick = 0;
+  uint32_t center = 0;
+
+  for (;;) {
+    frame = shm_export.frame(ring, &seq);
+
+    if (frame == (ShmFrame const *)NULL) {
+      return false;
+    }  // fi
+
+    tick = frame->tick_;
+    pixels = (uint8_t const *)(frame + 1);
+    center = *(uint32_t const *)(pixels + (frame->h_ / 2) * frame->pitch_ +
+                                 (frame->w_ / 2) * 4);
+
+    if (shm_export.valid(&frame->seq_, seq)) {
+      break;
+    }  // fi
+
+    *torn += 1;
+  }  // od
+
+  printf("  frame of tick %u, %d x %d, center 0x%08x\n", tick, frame->w_,
+         frame->h_, center);
+
+  return true;
+}  // peek_frame_()
+
+int main(int argc, char *argv[]) {
+  extern ShmExport shm_export;
+
+  ShmRing ring;
+
+  int seconds = (argc > 2) ? atoi(argv[2]) : 10;
+  int torn = 0;
+
+  if (argc < 2) {
+    printf("usage: %s <name> [seconds]\n", argv[0]);
+
+    return -1;
+  }  // fi
+
+  if (!shm_export.attach(&ring, argv[1])) {
+    printf("Peek Error: no game exports %s\n", argv[1]);
+
+    return -1;
+  }  // fi
+
+  for (int t = 0; t < seconds * 1000 / PEEK_INTERVAL; ++t) {
+    // 每秒印一次
+    if ((t % (1000 / PEEK_INTERVAL) == 0) && peek_state_(&ring, &torn)) {
+      peek_frame_(&ring, &torn);
+    }  // fi
+
+    SDL_Delay(PEEK_INTERVAL);
+  }  // od
+
+  printf("Peek: %d torn reads retried\n", torn);
+
+  shm_export.close(&ring);
+
+  return 0;
+}  // main()
+
+// peek.c